@@ -0,0 +1,154 @@
+/*
+    File:    parse_overhead.cpp
+    Created: 20 October 2026 at 18:10 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+/*
+ * The benchmark driver counts reference count atomics and allocations done by
+ * Regrule::compile per parsed rule. Each file from the command line is parsed
+ * number_of_repetitions times.
+ *
+ * Allocations are counted by the replaced global operator new. Atomics are counted
+ * only in the build with -fsanitize=thread, where every atomic operation of libstdc++
+ * is a call of an entry point of the sanitizer: the entry points used by reference
+ * counts of std::shared_ptr are wrapped by the linker (see bench/Makefile), and the
+ * wrappers below count the calls. A thread is started before parsing, since otherwise
+ * libstdc++ updates reference counts without atomics.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/get_processed_text.h"
+#include "../include/location.h"
+#include "../include/errors_and_tries.h"
+#include "../include/main_scaner.h"
+#include "../include/expr_scaner.h"
+#include "../include/expr_parser.h"
+#include "../include/scope.h"
+#include "../include/session.h"
+#include "../include/regrule.h"
+
+#ifdef COUNT_ATOMICS
+static size_t number_of_atomics = 0;
+#endif
+static size_t number_of_allocs  = 0;
+static size_t allocated_bytes   = 0;
+static bool   counting          = false;
+
+#ifdef COUNT_ATOMICS
+extern "C"{
+    int __real___tsan_atomic32_fetch_add(volatile int* a, int v, int mo);
+    int __real___tsan_atomic32_fetch_sub(volatile int* a, int v, int mo);
+
+    int __wrap___tsan_atomic32_fetch_add(volatile int* a, int v, int mo)
+    {
+        number_of_atomics += counting;
+        return __real___tsan_atomic32_fetch_add(a, v, mo);
+    }
+
+    int __wrap___tsan_atomic32_fetch_sub(volatile int* a, int v, int mo)
+    {
+        number_of_atomics += counting;
+        return __real___tsan_atomic32_fetch_sub(a, v, mo);
+    }
+};
+#endif
+
+void* operator new(size_t n)
+{
+    if(counting){
+        number_of_allocs++;
+        allocated_bytes += n;
+    }
+    void* p = malloc(n ? n : 1);
+    if(!p){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+static const char32_t* added_acts[] = {
+    U"write",                      U"write_by_code",
+    U"add_dec_digit_to_char_code", U"add_hex_digit_to_char_code",
+    U"add_bin_digit_to_char_code", U"add_oct_digit_to_char_code"
+};
+
+static void add_action(const Errors_and_tries&       etr,
+                       const std::shared_ptr<Scope>& scope,
+                       const std::u32string&         name)
+{
+    Id_attributes iattr;
+    iattr.kind_       = 1u << static_cast<uint8_t>(Id_kind::Action_name);
+    size_t idx        = etr.ids_trie->insert(name);
+    iattr.act_string_ = etr.strs_trie->insert(name + U"();");
+    scope->idsc_[idx] = iattr;
+}
+
+constexpr unsigned number_of_repetitions = 100;
+
+static const char* usage_str = "Usage: %s file...\n";
+
+int main(int argc, char* argv[])
+{
+    if(1 == argc){
+        printf(usage_str, argv[0]);
+        return 1;
+    }
+    std::thread([]{}).join();
+
+    std::vector<std::u32string> texts;
+    for(int i = 1; i < argc; ++i){
+        texts.push_back(get_processed_text(argv[i]));
+    }
+
+    /* Each repetition uses its own session, since a rule name can be defined only
+     * once in a scope. */
+    size_t parsed = 0;
+    int    errors = 0;
+    for(unsigned rep = 0; rep < number_of_repetitions; ++rep){
+        Session     session(Memory_resource_kind::Malloc);
+        const auto& et    = session.errors_and_tries();
+        auto        scope = session.scope();
+        for(const char32_t* name : added_acts){
+            add_action(et, scope, name);
+        }
+        for(const auto& text : texts){
+            char32_t* p   = const_cast<char32_t*>(text.c_str());
+            auto      loc = std::make_shared<Location>(p);
+            auto      esc = std::make_shared<Expr_scaner>(loc, et, session.sets_trie());
+            auto      msc = std::make_shared<Main_scaner>(loc, et);
+            auto      ep  = std::make_shared<Expr_parser>(esc, et, scope);
+            Regrule   rr(ep, msc, et, scope);
+            counting      = true;
+            auto      ri  = rr.compile();
+            counting      = false;
+            parsed++;
+        }
+        errors += et.ec->get_number_of_errors();
+    }
+
+    double n = static_cast<double>(parsed);
+    printf("parsed rules:           %zu\n", parsed);
+#ifdef COUNT_ATOMICS
+    printf("refcount atomics/rule:  %.2f\n", number_of_atomics / n);
+#endif
+    printf("allocations/rule:       %.2f\n", number_of_allocs / n);
+    printf("allocated bytes/rule:   %.1f\n", allocated_bytes / n);
+    printf("errors:                 %d\n", errors);
+    return 0;
+}
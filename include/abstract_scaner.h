@@ -12,6 +12,7 @@
 
 #include <string>
 #include <memory>
+#include <memory_resource>
 #include "../include/error_count.h"
 #include "../include/trie.h"
 #include "../include/location.h"
@@ -58,12 +59,13 @@ protected:
     std::shared_ptr<Char_trie>   strs;
 
     /* buffer for writing the processed identifier or string: */
-    std::u32string               buffer;
+    std::pmr::u32string          buffer;
 };
 
 template<typename Lexem_type>
 Abstract_scaner<Lexem_type>::Abstract_scaner(const Location_ptr& location,
-                                             const Errors_and_tries& et)
+                                             const Errors_and_tries& et) :
+    buffer(et.memory_resource)
 {
     ids              = et.ids_trie;
     strs             = et.strs_trie;
@@ -11,7 +11,12 @@
 #define AST_H
 #include <memory>
 #include <cstddef>
-#include <list>
+#include <new>
+#include <memory_resource>
+#include <utility>
+#include <algorithm>
+#include <vector>
+#include "../include/small_vector.h"
 namespace ast{
 
     struct Binary_op;
@@ -56,16 +61,25 @@ namespace ast{
         Kleene, Positive, Optional
     };
 
+    /* Children of a node are stored in a small vector: up to four children are placed
+     * inside the node itself, and a longer list of children is placed into the arena
+     * which contains the node. */
+    static constexpr size_t num_of_inline_children = 4;
+
+    using Children = Small_vector<Ast_elem*, num_of_inline_children>;
+
     struct Binary_op : public Ast_elem{
         Binary_op()                             = default;
         Binary_op(const Binary_op&)             = default;
         virtual ~Binary_op()                    = default;
 
-        Binary_op(Binary_op_kind kind, std::list<std::shared_ptr<Ast_elem>> children) :
-            kind_(kind), children_(children) {}
+        /* The list of children is moved into the node: if it is placed in the arena,
+         * then it is not copied. */
+        Binary_op(Binary_op_kind kind, Children&& children) :
+            kind_(kind), children_(std::move(children)) {}
 
-        Binary_op_kind                       kind_     = Binary_op_kind::Or;
-        std::list<std::shared_ptr<Ast_elem>> children_;
+        Binary_op_kind kind_     = Binary_op_kind::Or;
+        Children       children_;
 
         void apply_action(size_t act_idx) override;
 
@@ -80,11 +94,11 @@ namespace ast{
         Unary_op(const Unary_op&)        = default;
         virtual ~Unary_op()              = default;
 
-        Unary_op(Unary_op_kind kind, const std::shared_ptr<Ast_elem>& child) :
+        Unary_op(Unary_op_kind kind, Ast_elem* child) :
             kind_(kind), child_(child) {}
 
-        Unary_op_kind             kind_  = Unary_op_kind::Kleene;
-        std::shared_ptr<Ast_elem> child_ = nullptr;
+        Unary_op_kind kind_  = Unary_op_kind::Kleene;
+        Ast_elem*     child_ = nullptr;
 
         void apply_action(size_t act_idx) override;
 
@@ -175,15 +189,79 @@ namespace ast{
         }
     };
 
-    using Regexp = std::list<std::shared_ptr<Ast_elem>>;
+    using Regexp = Children;
+
+    /*
+     * The class Ast_arena owns the memory of nodes of an AST (as a rule, of all nodes
+     * of one regexp). Nodes are bump-allocated one after another, and are never freed
+     * individually: the whole memory of the arena is released at once, when the arena
+     * is destroyed. Therefore, destructors of nodes are not called, and nodes must not
+     * own any resources other than the memory of the arena.
+     */
+    class Ast_arena{
+    public:
+        explicit Ast_arena(std::pmr::memory_resource* upstream =
+                               std::pmr::get_default_resource()) :
+            buffer_(initial_size, upstream) {}
+        Ast_arena(const Ast_arena&)            = delete;
+        Ast_arena& operator=(const Ast_arena&) = delete;
+        ~Ast_arena()                           = default;
+
+        template<typename Node, typename... Args>
+        Node* create(Args&&... args)
+        {
+            void* p = buffer_.allocate(sizeof(Node), alignof(Node));
+            return new (p) Node(std::forward<Args>(args)...);
+        }
+
+        /* The resource from which, for example, long lists of children are allocated. */
+        std::pmr::memory_resource* resource()
+        {
+            return &buffer_;
+        }
+
+        /* If nodes of this arena refer to nodes of the arena other (for example, after
+         * substitution of the body of another regexp), then the arena other must live
+         * as long as this arena. The function retain provides this. */
+        void retain(const std::shared_ptr<Ast_arena>& other)
+        {
+            if(other && (other.get() != this) &&
+               (std::find(retained_.begin(), retained_.end(), other) == retained_.end()))
+            {
+                retained_.push_back(other);
+            }
+        }
+    private:
+        static constexpr size_t                 initial_size = 2048;
+        std::pmr::monotonic_buffer_resource     buffer_;
+        std::vector<std::shared_ptr<Ast_arena>> retained_;
+    };
 
+    using Ast_arena_ptr = std::shared_ptr<Ast_arena>;
+
+    /*
+     * The class Regexp_ast is a handle of an AST. All nodes of the AST are in the arena
+     * arena_, and the handle shares the ownership of the arena. Therefore, copies of
+     * Regexp_ast (for example, in Rule_info) refer to the same tree, and the tree is
+     * never modified or torn down by the destruction of one of copies. When the last
+     * handle is destroyed, the arena releases the memory of all nodes at once, without
+     * traversal of the tree, so that the destruction of a deeply nested tree neither
+     * recurses nor depends on the number of nodes.
+     */
     class Regexp_ast{
     public:
-        Regexp_ast()                  = default;
-        Regexp_ast(const Regexp_ast&) = default;
-        ~Regexp_ast();
+        Regexp_ast()                             = default;
+        Regexp_ast(const Regexp_ast&)            = default;
+        Regexp_ast(Regexp_ast&&)                 = default;
+        Regexp_ast& operator=(const Regexp_ast&) = default;
+        Regexp_ast& operator=(Regexp_ast&&)      = default;
+        ~Regexp_ast()                            = default;
+
+        Regexp_ast(const Ast_arena_ptr& arena, Ast_elem* root) :
+            arena_(arena), root_(root) {}
 
-        Regexp_ast(const std::shared_ptr<Ast_elem>& root) : root_(root) {}
+        Regexp_ast(Ast_arena_ptr&& arena, Ast_elem* root) :
+            arena_(std::move(arena)), root_(root) {}
 
         void traverse(Visitor& v) const{
             if(root_){
@@ -197,11 +275,16 @@ namespace ast{
             }
         }
 
-        std::shared_ptr<Ast_elem> get_root() const{
+        Ast_elem* get_root() const{
             return root_;
         }
+
+        const Ast_arena_ptr& get_arena() const{
+            return arena_;
+        }
     private:
-        std::shared_ptr<Ast_elem> root_;
+        Ast_arena_ptr arena_;
+        Ast_elem*     root_  = nullptr;
     };
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+    File:    ast_serialization.h
+    Created: 19 October 2026 at 18:35 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef AST_SERIALIZATION_H
+#define AST_SERIALIZATION_H
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../include/ast.h"
+#include "../include/flat_ast.h"
+#include "../include/regrule.h"
+#include "../include/errors_and_tries.h"
+#include "../include/trie_for_set.h"
+/*
+ * Binary representation of a sequence of rules. All numbers are written as unsigned
+ * LEB128 varints (seven bits per byte, the least significant group first, the high bit
+ * of a byte means that the number continues). The representation consists of
+ *      1) the magic "RGAST" and the version of the format;
+ *      2) the table of identifiers: the number of entries, and for each entry the index
+ *         of the identifier in the prefix tree of identifiers, the length of the
+ *         identifier and its characters;
+ *      3) the table of sets of characters: the number of entries, and for each entry
+ *         the index of the set in the prefix tree of sets, the number of characters,
+ *         and characters in ascending order, each written as the difference with the
+ *         previous character;
+ *      4) the number of rules, and for each rule the index of its name and its body.
+ * A body is written in pre-order. A node starts with the byte of the tag, whose lower
+ * seven bits are the kind of the node (the value of ast::Flat_kind, or empty_body for
+ * the empty body), and whose high bit means that the index of the action follows. Then
+ * Or and Concat contain the number of children and children, Kleene, Positive and
+ * Optional contain the child, and leaves contain the payload (the character, or the
+ * index of the set, or the index of the name).
+ *
+ * Since the tables contain texts of identifiers and sets, a loader in another process
+ * inserts them into its own prefix trees and replaces all indices accordingly.
+ */
+namespace ast{
+    struct Flat_rule_info{
+        size_t   name_;
+        Flat_ast body_;
+    };
+
+    /* This function writes the rules into the binary representation. */
+    std::string serialize_rules(const std::vector<Rule_info>& rules,
+                                const Errors_and_tries&       et,
+                                Trie_for_set_of_char32&       sets);
+
+    /**
+     * \brief Loading of the rules from the binary representation. Identifiers and sets
+     *        of characters are inserted into the prefix trees et.ids_trie and sets, and
+     *        the loaded rules refer to these prefix trees.
+     * \return true, if bytes contain a correct binary representation, and false
+     *         otherwise. In the latter case neither the prefix trees nor rules are
+     *         changed.
+     */
+    bool deserialize_rules(std::string_view             bytes,
+                           const Errors_and_tries&      et,
+                           Trie_for_set_of_char32&      sets,
+                           std::vector<Flat_rule_info>& rules);
+
+    /// \brief The same as the previous function, but for trees allocated in arenas.
+    bool deserialize_rules(std::string_view             bytes,
+                           const Errors_and_tries&      et,
+                           Trie_for_set_of_char32&      sets,
+                           std::vector<Rule_info>&      rules);
+};
+#endif
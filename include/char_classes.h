@@ -0,0 +1,103 @@
+/*
+    File:    char_classes.h
+    Created: 20 October 2026 at 10:05 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef CHAR_CLASSES_H
+#define CHAR_CLASSES_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../include/char_ranges.h"
+#include "../include/regrule.h"
+/*
+ * The class Char_classes is the partition of all code points from 0 to max_code_point
+ * into the minimal number of classes of equivalent characters: two characters are
+ * equivalent if each of the given labels either contains both of them or contains
+ * none of them. Hence each label is a union of classes, and an automaton whose
+ * transitions are labelled by these labels can use numbers of classes as its alphabet.
+ *
+ * Classes are numbered in the order of their least characters. The class of a character
+ * is found by the two-level table: the high part c >> block_bits of the character c
+ * selects a block of 2^block_bits numbers of classes, and the low part selects the
+ * number in the block. Equal blocks are stored only once, so for the whole Unicode the
+ * table usually takes a few kilobytes.
+ */
+class Char_classes{
+public:
+    static constexpr uint32_t no_class   = UINT32_MAX;
+    static constexpr unsigned block_bits = 8;
+    static constexpr size_t   block_size = size_t{1} << block_bits;
+
+    Char_classes()                               = default;
+    Char_classes(const Char_classes&)            = default;
+    Char_classes(Char_classes&&)                 = default;
+    Char_classes& operator=(const Char_classes&) = default;
+    Char_classes& operator=(Char_classes&&)      = default;
+    ~Char_classes()                              = default;
+
+    /* Builds classes for the labels from the list used_labels of the table labels. */
+    Char_classes(const Label_table& labels, const std::vector<uint32_t>& used_labels);
+
+    size_t number_of_classes() const {return ranges_.size();};
+
+    uint32_t class_of(char32_t c) const
+    {
+        if(c > max_code_point){
+            return no_class;
+        }
+        return blocks_[(size_t{index_[c >> block_bits]} << block_bits) +
+                       (c & (block_size - 1))];
+    }
+
+    /* Characters of the class cls: */
+    const Char_ranges& ranges(uint32_t cls) const {return ranges_[cls];};
+
+    /* Classes whose union is the label l; the label must be from the list used_labels.
+     * The classes are label_classes_[label_begin_[l]], ...,
+     * label_classes_[label_begin_[l + 1] - 1], in ascending order. */
+    const uint32_t* label_classes_begin(uint32_t l) const
+    {
+        return label_classes_.data() + label_begin_[l];
+    }
+
+    const uint32_t* label_classes_end(uint32_t l) const
+    {
+        return label_classes_.data() + label_begin_[l + 1];
+    }
+
+    size_t number_of_blocks() const {return blocks_.size() / block_size;};
+
+    /* The two-level table itself, for generators of scanners: */
+    const std::vector<uint16_t>& index()  const {return index_;};
+    const std::vector<uint32_t>& blocks() const {return blocks_;};
+
+    /* The size of the two-level table in bytes: */
+    size_t table_size() const
+    {
+        return index_.size() * sizeof(index_[0]) + blocks_.size() * sizeof(blocks_[0]);
+    }
+private:
+    std::vector<uint16_t>    index_;
+    std::vector<uint32_t>    blocks_;
+    std::vector<Char_ranges> ranges_;
+    std::vector<uint32_t>    label_begin_;
+    std::vector<uint32_t>    label_classes_;
+
+    void build_table(const std::vector<char32_t>& bounds,
+                     const std::vector<uint32_t>& seg_class);
+};
+
+/**
+ * \brief Collects labels of all leaves (characters, character classes and complements
+ *        of character classes) of bodies of the rules. Labels are added into the table
+ *        labels, if necessary.
+ * \return Numbers of labels, in ascending order, without repetitions.
+ */
+std::vector<uint32_t> collect_labels(const std::vector<Rule_info>& rules,
+                                     Label_table&                  labels);
+#endif
@@ -0,0 +1,63 @@
+/*
+    File:    char_ranges.h
+    Created: 19 October 2026 at 19:58 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef CHAR_RANGES_H
+#define CHAR_RANGES_H
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include "../include/knuth_find.h"
+#include "../include/flat_ast.h"
+#include "../include/trie_for_set.h"
+
+/* The maximal code point of Unicode. */
+constexpr char32_t max_code_point = 0x10FFFF;
+
+/* A set of characters represented as a sorted list of disjoint and non-adjacent
+ * segments of code points. */
+using Char_ranges = std::vector<Segment<char32_t>>;
+
+Char_ranges set_to_ranges(const std::set<char32_t>& s);
+
+/* The complement of the set r with respect to [0, max_code_point]. */
+Char_ranges complement_ranges(const Char_ranges& r);
+
+bool ranges_contain(const Char_ranges& r, char32_t c);
+
+/*
+ * The class Label_table numbers different labels of leaves of regexps. A label is
+ * the set of characters matched by a leaf: a single character for Character_leaf, the
+ * set from the prefix tree of sets for Char_class_leaf, and the complement of such a
+ * set for Char_class_compl_leaf. Equal leaves get the same number, and each label is
+ * converted to segments only once. The label with the number 0 is the empty set; it is
+ * used for leaves which do not match any character (e.g., unresolved regexp names).
+ */
+class Label_table{
+public:
+    Label_table()                   = default;
+    Label_table(const Label_table&) = default;
+    ~Label_table()                  = default;
+
+    explicit Label_table(const Trie_for_set_of_char32ptr& sets) :
+        sets_(sets), ranges_(1) {}
+
+    /* The number of the label of the leaf with the kind k and the payload payload. */
+    uint32_t label_of(ast::Flat_kind k, uint64_t payload);
+
+    const Char_ranges& ranges(uint32_t label) const {return ranges_[label];};
+    size_t             size()                 const {return ranges_.size();};
+private:
+    Trie_for_set_of_char32ptr                           sets_;
+    std::vector<Char_ranges>                            ranges_;
+    std::map<std::pair<ast::Flat_kind, uint64_t>, uint32_t> ids_;
+};
+#endif
@@ -10,12 +10,16 @@
 #define CHAR_TRIE_H
 
 #include "../include/trie.h"
+#include <deque>
+#include <string>
+#include <vector>
 
 class Char_trie : public Trie<char32_t>{
 public:
     virtual ~Char_trie() { };
 
-    Char_trie(){};
+    Char_trie(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) :
+        Trie<char32_t>(mr) {};
 
     Char_trie(const Char_trie& orig) = default;
 
@@ -29,5 +33,19 @@ public:
     /* The following function returns the length of the string
      * corresponding to the index idx. */
     size_t get_length(size_t idx);
+
+    /* This function returns the string corresponding to the index idx in the encoding
+     * UTF-8. Strings are built at the first request and then are taken from the cache,
+     * so the returned reference remains valid while the prefix tree exists. */
+    const std::string& get_utf8_string(size_t idx);
+protected:
+    void contents_replaced() override;
+private:
+    /* If utf8_slots_[idx] is not zero, then utf8_names_[utf8_slots_[idx] - 1] is the
+     * string corresponding to the index idx in the encoding UTF-8. Since std::deque
+     * does not move its elements when new elements are appended to the end, the
+     * references to cached strings are stable. */
+    std::vector<size_t>     utf8_slots_;
+    std::deque<std::string> utf8_names_;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+    File:    comb_scanner.h
+    Created: 20 October 2026 at 17:02 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef COMB_SCANNER_H
+#define COMB_SCANNER_H
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+/*
+ * This header is the runtime of scanners generated by generate_table_scanner, and does
+ * not depend on other headers of the project, so it can be shipped together with the
+ * generated tables.
+ *
+ * The class of a character c <= 0x10FFFF is class_blocks_[(class_index_[h] << 8) +
+ * (c & 255)], where h = min(c >> 8, class_index_size_ - 1): blocks of 256 characters
+ * after the last stored entry of class_index_ have the same classes as the block of
+ * this entry, so the index is cut after the start of its last run.
+ *
+ * Transitions are compressed by row displacement (a comb): the row of the state s is
+ * stored as the entries next_[base_[s] + k], for which check_[base_[s] + k] == s,
+ * interleaved with rows of other states. A class k without an entry is looked up in
+ * the row of the default state default_[s], whose row is similar to the row of s;
+ * no_state in next_ means that there is no transition, and no_state in default_ means
+ * that there is no default state. The arrays next_ and check_ are padded, so that
+ * base_[s] + k is a valid index for any class k.
+ *
+ * accept_[s] is the token accepted in the state s, or no_token.
+ *
+ * If the scanner has actions, then actions_[i] is the set of actions of the transition
+ * stored as next_[i], and the set a consists of the pairs (action_token_[j],
+ * action_id_[j]) for j from action_set_begin_[a] to action_set_begin_[a + 1] - 1: the
+ * action action_id_[j] is demanded by the token action_token_[j]. The set 0 is empty.
+ * If there are no actions, then these pointers are null.
+ */
+template<typename State, typename Index, typename Token, typename Class, typename Set>
+struct Comb_tables{
+    static constexpr State    no_state       = std::numeric_limits<State>::max();
+    static constexpr Token    no_token       = std::numeric_limits<Token>::max();
+    static constexpr char32_t max_code_point = 0x10FFFF;
+
+    const uint16_t* class_index_;
+    size_t          class_index_size_;
+    const Class*    class_blocks_;
+    const Index*    base_;
+    const State*    default_;
+    const State*    next_;
+    const State*    check_;
+    const Token*    accept_;
+    const Set*      actions_;
+    const uint32_t* action_set_begin_;
+    const Token*    action_token_;
+    const uint32_t* action_id_;
+    State           start_;
+
+    Class class_of(char32_t c) const
+    {
+        size_t h = c >> 8;
+        if(h >= class_index_size_){
+            h = class_index_size_ - 1;
+        }
+        return class_blocks_[(size_t{class_index_[h]} << 8) + (c & 255)];
+    }
+
+    /* The index of the transition from s by k in next_, or no_entry: */
+    static constexpr size_t no_entry = std::numeric_limits<size_t>::max();
+
+    size_t entry(State s, Class k) const
+    {
+        for(;;){
+            size_t i = size_t{base_[s]} + k;
+            if(check_[i] == s){
+                return i;
+            }
+            s = default_[s];
+            if(s == no_state){
+                return no_entry;
+            }
+        }
+    }
+
+    State next_state(State s, Class k) const
+    {
+        size_t i = entry(s, k);
+        return (i == no_entry) ? no_state : next_[i];
+    }
+
+    /**
+     * \brief Search of the longest token at p.
+     * \return The accepted token, or -1, if there is no token at p. In the former
+     *         case, p is moved to the end of the token.
+     */
+    long longest_match(const char32_t*& p, const char32_t* end) const
+    {
+        long            result   = -1;
+        const char32_t* last_end = p;
+        State           s        = start_;
+        if(s == no_state){
+            return result;
+        }
+        if(accept_[s] != no_token){
+            result = accept_[s];
+        }
+        for(const char32_t* q = p; q != end; ++q){
+            if(*q > max_code_point){
+                break;
+            }
+            s = next_state(s, class_of(*q));
+            if(s == no_state){
+                break;
+            }
+            if(accept_[s] != no_token){
+                result   = accept_[s];
+                last_end = q + 1;
+            }
+        }
+        p = last_end;
+        return result;
+    }
+
+    /**
+     * \brief The same as the previous function, but the actions of the found token are
+     *        executed: for each character of the token, and for each action demanded
+     *        by the token on the transition by this character, handler(action, c) is
+     *        called. Since the token is known only at its end, the transitions are
+     *        walked again, so actions of other tokens and of characters after the end
+     *        of the token are never executed.
+     */
+    template<typename Handler>
+    long longest_match(const char32_t*& p, const char32_t* end, Handler&& handler) const
+    {
+        const char32_t* begin  = p;
+        long            result = longest_match(p, end);
+        if((result == -1) || !actions_){
+            return result;
+        }
+        State s = start_;
+        for(const char32_t* q = begin; q != p; ++q){
+            size_t i = entry(s, class_of(*q));
+            s        = next_[i];
+            Set    a = actions_[i];
+            for(uint32_t j = action_set_begin_[a]; j != action_set_begin_[a + 1]; ++j){
+                if(action_token_[j] == result){
+                    handler(action_id_[j], *q);
+                }
+            }
+        }
+        return result;
+    }
+};
+#endif
@@ -0,0 +1,102 @@
+/*
+    File:    concurrent_interner.h
+    Created: 19 October 2026 at 09:12 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef CONCURRENT_INTERNER_H
+#define CONCURRENT_INTERNER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../include/char_trie.h"
+
+/*
+ * The class Concurrent_interner is a replacement of the prefix tree Char_trie for the
+ * case when several threads parse texts simultaneously. The table of strings is divided
+ * into shards, and each shard is protected by its own mutex. The shard of a string is
+ * determined by the hash of this string, so threads that intern different strings
+ * almost never wait for each other.
+ *
+ * Each non-empty string receives an id from the range 1, 2, ..., n, where n is the
+ * number of interned strings. The empty string always has the id 0, just as the root
+ * of a prefix tree. The same string gets the same id in all threads. However, the
+ * ids depend on the order in which the threads inserted the strings. Therefore, after
+ * the parallel phase, one must call the member function renumber(), which assigns ids
+ * in the lexicographic order of strings, so that the final result is reproducible.
+ */
+class Concurrent_interner{
+public:
+    static constexpr size_t default_num_of_shards = 64;
+
+    explicit Concurrent_interner(size_t num_of_shards = default_num_of_shards);
+    Concurrent_interner(const Concurrent_interner&)            = delete;
+    Concurrent_interner& operator=(const Concurrent_interner&) = delete;
+    ~Concurrent_interner()                                     = default;
+
+    /**
+     * \brief The function of inserting into the table of strings. This function can
+     *        be called simultaneously from several threads.
+     * \param [in] s Inserted string s.
+     * \return       The id of the string s.
+     */
+    size_t insert(const std::u32string& s);
+
+    /**
+     * \brief Search of the string s without inserting. This function can be called
+     *        simultaneously from several threads.
+     * \param [in] s The wanted string.
+     * \return       The pair (true, id of s), if s is interned, and (false, 0) otherwise.
+     */
+    std::pair<bool, size_t> find(const std::u32string& s) const;
+
+    /// \brief The number of interned non-empty strings.
+    size_t size() const;
+
+    /**
+     * \brief This function builds the table of all interned strings: the element with
+     *        the index i of the result is the string with the id i. The function must
+     *        not be called while other threads insert strings.
+     */
+    std::vector<std::u32string> get_strings() const;
+
+    /**
+     * \brief Deterministic renumbering of ids: after this function the ids of strings
+     *        are assigned in the lexicographic order of strings. The function must not
+     *        be called while other threads insert strings.
+     * \return The mapping of old ids into new ids: the element with the index i of the
+     *         result is the new id of the string that had the id i.
+     */
+    std::vector<size_t> renumber();
+
+    /**
+     * \brief This function inserts all interned strings into the prefix tree t in the
+     *        order of their ids. If renumber() has been called before, then the
+     *        resulting prefix tree does not depend on the order of insertions made by
+     *        threads. The function must not be called while other threads insert strings.
+     * \return The mapping of ids into indices in the prefix tree t.
+     */
+    std::vector<size_t> export_to_trie(Char_trie& t) const;
+private:
+    /* Each shard occupies its own cache line, so that mutexes of neighbouring shards
+     * do not cause false sharing. */
+    struct alignas(64) Shard{
+        mutable std::mutex                         mtx_;
+        std::unordered_map<std::u32string, size_t> ids_;
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t                   shards_mask_;
+    std::atomic<size_t>      next_id_;
+
+    Shard& shard_for(const std::u32string& s) const;
+};
+#endif
@@ -0,0 +1,138 @@
+/*
+    File:    dense_bitset.h
+    Created: 19 October 2026 at 19:40 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef DENSE_BITSET_H
+#define DENSE_BITSET_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+/*
+ * The class Dense_bitset is a set of integers from the segment [0, size()), packed into
+ * 64-bit words: the integer i belongs to the set if and only if the bit i % 64 of the
+ * word i / 64 is set. Unions and iteration over elements are performed a word at a time.
+ */
+class Dense_bitset{
+public:
+    static constexpr size_t bits_per_word = 64;
+
+    Dense_bitset()                               = default;
+    Dense_bitset(const Dense_bitset&)            = default;
+    Dense_bitset(Dense_bitset&&)                 = default;
+    Dense_bitset& operator=(const Dense_bitset&) = default;
+    Dense_bitset& operator=(Dense_bitset&&)      = default;
+    ~Dense_bitset()                              = default;
+
+    explicit Dense_bitset(size_t n) : words_(num_of_words(n), 0), size_(n) {}
+
+    static size_t num_of_words(size_t n)
+    {
+        return (n + bits_per_word - 1) / bits_per_word;
+    }
+
+    void resize(size_t n)
+    {
+        words_.resize(num_of_words(n), 0);
+        size_ = n;
+    }
+
+    size_t size() const {return size_;};
+
+    void set(size_t i)
+    {
+        words_[i / bits_per_word] |= uint64_t{1} << (i % bits_per_word);
+    }
+
+    void reset(size_t i)
+    {
+        words_[i / bits_per_word] &= ~(uint64_t{1} << (i % bits_per_word));
+    }
+
+    bool test(size_t i) const
+    {
+        return (words_[i / bits_per_word] >> (i % bits_per_word)) & 1;
+    }
+
+    /* Removes all elements; the size is not changed. */
+    void clear()
+    {
+        for(auto& w : words_){
+            w = 0;
+        }
+    }
+
+    bool any() const
+    {
+        for(auto w : words_){
+            if(w){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t count() const
+    {
+        size_t result = 0;
+        for(auto w : words_){
+            result += __builtin_popcountll(w);
+        }
+        return result;
+    }
+
+    /**
+     * \brief Union with the set given by n words w, the first of which is the word
+     *        with the number first_word of this set.
+     */
+    void or_words(const uint64_t* w, size_t first_word, size_t n)
+    {
+        uint64_t* dst = words_.data() + first_word;
+        for(size_t k = 0; k < n; ++k){
+            dst[k] |= w[k];
+        }
+    }
+
+    Dense_bitset& operator|=(const Dense_bitset& other)
+    {
+        or_words(other.words_.data(), 0, other.words_.size());
+        return *this;
+    }
+
+    bool operator==(const Dense_bitset& other) const
+    {
+        return (size_ == other.size_) && (words_ == other.words_);
+    }
+
+    /* Calls f(i) for all elements i of the set, in ascending order. */
+    template<typename F>
+    void for_each(F f) const
+    {
+        for_each_in_words(words_.data(), 0, words_.size(), f);
+    }
+
+    /* The same as for_each, but for the set given by n words w starting with the word
+     * with the number first_word. */
+    template<typename F>
+    static void for_each_in_words(const uint64_t* w, size_t first_word, size_t n, F f)
+    {
+        for(size_t k = 0; k < n; ++k){
+            uint64_t word = w[k];
+            while(word){
+                f((first_word + k) * bits_per_word + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    const uint64_t* words()           const {return words_.data();};
+    size_t          number_of_words() const {return words_.size();};
+private:
+    std::vector<uint64_t> words_;
+    size_t                size_  = 0;
+};
+#endif
@@ -0,0 +1,88 @@
+/*
+    File:    dfa.h
+    Created: 19 October 2026 at 22:47 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef DFA_H
+#define DFA_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../include/char_classes.h"
+/* The result of the search of the longest match by a deterministic automaton: */
+struct Dfa_match{
+    size_t   length_  = 0;
+    uint32_t rule_id_ = UINT32_MAX; ///< UINT32_MAX, if there is no match
+};
+
+/*
+ * The structure Dfa is a deterministic finite automaton over an alphabet of symbols.
+ * Symbols are numbers of classes of equivalent characters from classes_, so the symbol
+ * of a character is found by two lookups in a table. Transitions are stored by rows:
+ * the transition from the state s by the symbol j is
+ * transitions_[s * number_of_symbols() + j], and no_state means that the automaton
+ * stops.
+ *
+ * accept_[s] is the number of the rule accepted in the state s, or no_state, if s is
+ * not accepting. If some transitions execute actions, then trans_actions_ has the same
+ * size as transitions_, and trans_actions_[k] is the index in action_sets_ of the set
+ * of actions executed by the transition number k. The set with the index 0 is empty.
+ * If there are no actions at all, then trans_actions_ is empty.
+ */
+struct Dfa{
+    static constexpr uint32_t no_state = UINT32_MAX;
+
+    Char_classes                       classes_;
+    std::vector<uint32_t>              transitions_;
+    std::vector<uint32_t>              accept_;
+    std::vector<uint32_t>              trans_actions_;
+    std::vector<std::vector<uint64_t>> action_sets_;
+    uint32_t                           start_         = no_state;
+    /* The set of actions executed before the first character: */
+    uint32_t                           start_actions_ = 0;
+
+    size_t number_of_symbols() const {return classes_.number_of_classes();};
+
+    size_t number_of_states() const {return accept_.size();};
+
+    bool has_actions() const {return !trans_actions_.empty();};
+
+    /* The symbol of c, or Char_classes::no_class, if c > max_code_point: */
+    uint32_t symbol_of(char32_t c) const {return classes_.class_of(c);};
+
+    uint32_t next(uint32_t s, uint32_t symbol) const
+    {
+        return transitions_[s * number_of_symbols() + symbol];
+    }
+
+    /* The longest prefix of the string from begin to end, accepted by the automaton. */
+    Dfa_match longest_match(const char32_t* begin, const char32_t* end) const
+    {
+        Dfa_match result;
+        uint32_t  s = start_;
+        if(s == no_state){
+            return result;
+        }
+        result.rule_id_ = accept_[s];
+        for(const char32_t* p = begin; p != end; ++p){
+            uint32_t symbol = symbol_of(*p);
+            if(symbol == Char_classes::no_class){
+                break;
+            }
+            s = next(s, symbol);
+            if(s == no_state){
+                break;
+            }
+            if(accept_[s] != no_state){
+                result.length_  = (p - begin) + 1;
+                result.rule_id_ = accept_[s];
+            }
+        }
+        return result;
+    }
+};
+#endif
@@ -0,0 +1,55 @@
+/*
+    File:    direct_scanner_gen.h
+    Created: 20 October 2026 at 15:26 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef DIRECT_SCANNER_GEN_H
+#define DIRECT_SCANNER_GEN_H
+#include <string>
+#include "../include/lexer_dfa.h"
+#include "../include/scope.h"
+#include "../include/errors_and_tries.h"
+
+struct Scanner_code{
+    std::string header_; ///< the text of the header with the class of the scanner;
+    std::string impl_;   ///< the text of the implementation of the scanner.
+};
+
+/**
+ * \brief Generation of a direct-coded scanner from the automaton lexer. The scanner is
+ *        the class class_name with the member function
+ *            int next_token(const char32_t*& p, const char32_t* end);
+ *        which returns the index of the longest token at p (an element of the enum
+ *        Token), or None, and moves p to the end of the token.
+ *
+ *        Each state of the automaton becomes a label, and transitions are gotos.
+ *        The character is tested without tables of classes: if a target is reached
+ *        by several ASCII ranges, then by a bitmap of 128 bits in two constants; if
+ *        a state has many ranges, then ASCII characters are tested by a switch, and
+ *        other ranges by a binary search; and otherwise by comparisons.
+ *
+ *        The sets of actions of the transitions (tags, see lexer_dfa.h) are recorded
+ *        while the automaton goes forward. When the token is matched, the transitions
+ *        up to its end are replayed, and only the actions tagged with this token are
+ *        executed: for an action, the string Id_attributes::act_string_ from scope is
+ *        inserted, and the consumed character is available in the code of actions as
+ *        the variable ch. Thus neither the actions of other tokens nor the actions
+ *        of characters after the end of the token are executed.
+ *
+ *        Strings of the kinds Header_additions, Impl_additions and Added_members are
+ *        inserted into the header, into the implementation and into the class.
+ *
+ *        An action without a definition is diagnosed, and the number of errors is
+ *        increased.
+ * \param [in] header_name The name of the file of the header, for #include.
+ */
+Scanner_code generate_direct_scanner(const Lexer_dfa&        lexer,
+                                     const Scope&            scope,
+                                     const Errors_and_tries& et,
+                                     const std::string&      class_name,
+                                     const std::string&      header_name);
+#endif
@@ -13,10 +13,13 @@
 #include "../include/error_count.h"
 #include "../include/char_trie.h"
 #include <memory>
+#include <memory_resource>
 struct Errors_and_tries{
     std::shared_ptr<Error_count>  ec;
     std::shared_ptr<Char_trie>    ids_trie;
     std::shared_ptr<Char_trie>    strs_trie;
+    /* the memory resource from which scanners and parsers allocate memory: */
+    std::pmr::memory_resource*    memory_resource = std::pmr::get_default_resource();
 
     Errors_and_tries()  = default;
     ~Errors_and_tries() = default;
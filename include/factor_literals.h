@@ -0,0 +1,28 @@
+/*
+    File:    factor_literals.h
+    Created: 19 October 2026 at 16:52 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef FACTOR_LITERALS_H
+#define FACTOR_LITERALS_H
+#include "../include/ast.h"
+namespace ast{
+    /**
+     * \brief Prefix factoring of alternations of literals. A literal is a character or
+     *        a concatenation of characters, without actions. If an alternation contains
+     *        two or more literals, then these literals are inserted into a prefix tree,
+     *        and are replaced by one subtree having the shape of the prefix tree. For
+     *        example, if|int|interface|import is replaced by
+     *              i(f|n(t(erface)?)|mport).
+     *        The size of the resulting subtree is proportional to the number of nodes of
+     *        the prefix tree, i.e. each common prefix is represented only once. Other
+     *        alternatives are not changed. The tree is not modified: new nodes are
+     *        allocated in the arena of the tree, and unchanged subtrees are shared.
+     */
+    Regexp_ast factor_literals(const Regexp_ast& tree);
+};
+#endif
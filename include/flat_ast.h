@@ -0,0 +1,128 @@
+/*
+    File:    flat_ast.h
+    Created: 19 October 2026 at 14:05 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef FLAT_AST_H
+#define FLAT_AST_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory_resource>
+#include "../include/ast.h"
+namespace ast{
+    /* Kinds of nodes of the flat AST. */
+    enum class Flat_kind : uint8_t{
+        Or,          Concat,
+        Kleene,      Positive,   Optional,
+        Regexp_name, Character,  Char_class, Char_class_compl
+    };
+
+    /*
+     * The structure Flat_ast is an AST stored as a structure of arrays. A node is
+     * identified by its index i, and its fields are
+     *      kinds_[i]            the kind of the node;
+     *      first_child_[i]      the index in the array children_ of the first child;
+     *      num_of_children_[i]  the number of children;
+     *      payloads_[i]         the character (for Character), the index of the set of
+     *                           characters (for Char_class and Char_class_compl), the
+     *                           index of the name of the regexp (for Regexp_name), and 0
+     *                           for inner nodes;
+     *      actions_[i]          the index of the action (the field action_idx_).
+     * Children of the node i are children_[first_child_[i]], ...,
+     * children_[first_child_[i] + num_of_children_[i] - 1].
+     *
+     * Nodes are stored in post-order: every child precedes its parent, and the root is
+     * the last node. Hence, a bottom-up pass over the tree (for example, computation of
+     * nullable, firstpos and lastpos) is a single loop from 0 to size() - 1, and
+     * a top-down pass is the same loop in the reverse order.
+     */
+    struct Flat_ast{
+        static constexpr uint32_t no_node = UINT32_MAX;
+
+        std::vector<uint8_t>  kinds_;
+        std::vector<uint32_t> first_child_;
+        std::vector<uint32_t> num_of_children_;
+        std::vector<uint64_t> payloads_;
+        std::vector<uint64_t> actions_;
+        std::vector<uint32_t> children_;
+
+        size_t    size()               const {return kinds_.size();};
+        bool      empty()              const {return kinds_.empty();};
+        uint32_t  root()               const
+        {
+            return kinds_.empty() ? no_node : static_cast<uint32_t>(kinds_.size() - 1);
+        }
+
+        Flat_kind kind(uint32_t i)     const {return static_cast<Flat_kind>(kinds_[i]);};
+
+        const uint32_t* children_begin(uint32_t i) const
+        {
+            return children_.data() + first_child_[i];
+        }
+
+        const uint32_t* children_end(uint32_t i) const
+        {
+            return children_.data() + first_child_[i] + num_of_children_[i];
+        }
+
+        /**
+         * \brief Appends a node. All nodes with indices from children must be already
+         *        added.
+         * \return The index of the added node.
+         */
+        uint32_t add_node(Flat_kind       k,
+                          const uint32_t* children,
+                          size_t          num_of_children,
+                          uint64_t        payload,
+                          uint64_t        action);
+
+        void clear();
+    };
+
+    /* Description of a node of the tree: the kind, the payload and the children. */
+    struct Node_descr{
+        Flat_kind        kind_            = Flat_kind::Or;
+        uint64_t         payload_         = 0;
+        Ast_elem* const* children_        = nullptr;
+        size_t           num_of_children_ = 0;
+    };
+
+    /* This function returns the description of the node elem of a tree. */
+    Node_descr describe(Ast_elem* elem);
+
+    /* This function converts the tree into the flat representation. */
+    Flat_ast to_flat(const Regexp_ast& tree);
+
+    /**
+     * \brief This function converts the flat representation into the tree. Nodes of
+     *        the tree are allocated in a new arena whose memory is taken from upstream.
+     */
+    Regexp_ast from_flat(const Flat_ast&            fa,
+                         std::pmr::memory_resource* upstream =
+                             std::pmr::get_default_resource());
+
+    /**
+     * \brief The same as the previous function, but only the nodes reachable from the
+     *        node root are converted. Every node of fa is converted once, so nodes
+     *        shared in fa (for example, in the DAG of Hashcons_builder) are shared in
+     *        the tree too. If root is Flat_ast::no_node, then the tree is empty.
+     */
+    Regexp_ast from_flat(const Flat_ast&            fa,
+                         uint32_t                   root,
+                         std::pmr::memory_resource* upstream =
+                             std::pmr::get_default_resource());
+
+    /**
+     * \brief Calculation of the predicate nullable for all nodes.
+     * \return The vector whose i-th element is 1, if the language of the node i contains
+     *         the empty string, and 0 otherwise. The name of a regexp is considered as
+     *         non-nullable, because it is not expanded.
+     */
+    std::vector<uint8_t> nullable(const Flat_ast& fa);
+};
+#endif
@@ -0,0 +1,131 @@
+/*
+    File:    glushkov.h
+    Created: 19 October 2026 at 20:26 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef GLUSHKOV_H
+#define GLUSHKOV_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../include/ast.h"
+#include "../include/flat_ast.h"
+#include "../include/char_ranges.h"
+#include "../include/dense_bitset.h"
+/*
+ * The class Position_automaton is the Glushkov automaton (the position automaton) of
+ * a regexp. Positions are leaves of the tree (characters, character classes and their
+ * complements), numbered from 0 in the order of the post-order traversal, i.e. from
+ * left to right. For each position, its label (the number of the set of characters in
+ * the table of labels) and its action are stored.
+ *
+ * The flat AST must be a tree rather than a DAG with shared nodes. Then leaves of any
+ * subtree have consecutive numbers, and the sets firstpos and lastpos of a node are
+ * stored as bitsets covering only the segment of positions of this node. The words
+ * of these bitsets are aligned as words of a bitset of all positions, so they are
+ * combined with such bitsets without shifts. The relation followpos is not
+ * stored as a set of positions for each position: instead, for each position p the
+ * list of nodes is stored whose firstpos are subsets of followpos(p). This list contains
+ * at most one node for each ancestor of p, except for runs of nullable operands of
+ * concatenations, and followpos(p) is obtained by the union of these firstpos, a word
+ * at a time.
+ *
+ * A name of a regexp that remained unresolved is a position with the empty label
+ * (the label 0), i.e. a position which does not match any character.
+ */
+class Position_automaton{
+public:
+    Position_automaton()                          = default;
+    Position_automaton(const Position_automaton&) = default;
+    Position_automaton(Position_automaton&&)      = default;
+    ~Position_automaton()                         = default;
+
+    Position_automaton(const ast::Flat_ast& fa, Label_table& labels);
+    Position_automaton(const ast::Regexp_ast& tree, Label_table& labels);
+
+    size_t   number_of_positions()        const {return labels_.size();};
+    uint32_t label(uint32_t p)            const {return labels_[p];};
+    uint64_t action(uint32_t p)           const {return actions_[p];};
+    /* The index of the leaf in the flat tree corresponding to the position p. */
+    uint32_t leaf(uint32_t p)             const {return leaves_[p];};
+
+    /* true, if the regexp matches the empty string: */
+    bool     nullable()                   const {return root_nullable_;};
+    size_t   number_of_unresolved_names() const {return num_of_unresolved_;};
+
+    /*
+     * The following functions add the positions of the corresponding sets to the
+     * bitset out, which must have the size number_of_positions(). The bitset is not
+     * cleared before.
+     */
+    void first_positions(Dense_bitset& out) const;
+    void last_positions(Dense_bitset& out) const;
+    void follow_positions(uint32_t p, Dense_bitset& out) const;
+
+    /* Calls f(p) for all positions p from lastpos of the whole regexp. */
+    template<typename F>
+    void for_each_last_position(F f) const
+    {
+        if(root_ != ast::Flat_ast::no_node){
+            for_each_in(lastpos_, root_, f);
+        }
+    }
+private:
+    /* Data of the node i of the tree: */
+    std::vector<uint32_t>  first_pos_;    ///< the first position of the node;
+    std::vector<uint32_t>  end_pos_;      ///< the position after the last one;
+    std::vector<size_t>    offsets_;      ///< where words of sets are in pools;
+    std::vector<uint8_t>   nullable_;
+
+    std::vector<uint64_t>  firstpos_;     ///< the pool of words of sets firstpos;
+    std::vector<uint64_t>  lastpos_;      ///< the pool of words of sets lastpos;
+
+    /* Data of the position p: */
+    std::vector<uint32_t>  labels_;
+    std::vector<uint64_t>  actions_;
+    std::vector<uint32_t>  leaves_;
+    /* Nodes whose firstpos form followpos(p) are follow_nodes_[follow_begin_[p]], ...,
+     * follow_nodes_[follow_begin_[p + 1] - 1]: */
+    std::vector<uint32_t>  follow_begin_;
+    std::vector<uint32_t>  follow_nodes_;
+
+    uint32_t               root_              = ast::Flat_ast::no_node;
+    bool                   root_nullable_     = true;
+    size_t                 num_of_unresolved_ = 0;
+
+    void build(const ast::Flat_ast& fa, Label_table& labels);
+    void number_positions(const ast::Flat_ast& fa, Label_table& labels);
+    void calc_sets(const ast::Flat_ast& fa);
+    void calc_follow(const ast::Flat_ast& fa);
+
+    size_t first_word(uint32_t node) const
+    {
+        return first_pos_[node] / Dense_bitset::bits_per_word;
+    }
+
+    size_t num_of_words(uint32_t node) const
+    {
+        if(first_pos_[node] == end_pos_[node]){
+            return 0;
+        }
+        return (end_pos_[node] - 1) / Dense_bitset::bits_per_word - first_word(node) + 1;
+    }
+
+    void or_set(std::vector<uint64_t>& pool, uint32_t dst, uint32_t src);
+
+    /* Calls f(p, node) for all pairs such that firstpos(node) is in followpos(p): */
+    template<typename F>
+    void for_each_follow_pair(const ast::Flat_ast& fa, F f) const;
+
+    template<typename F>
+    void for_each_in(const std::vector<uint64_t>& pool, uint32_t node, F f) const
+    {
+        Dense_bitset::for_each_in_words(pool.data() + offsets_[node], first_word(node),
+                                        num_of_words(node), f);
+    }
+};
+#endif
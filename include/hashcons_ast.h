@@ -0,0 +1,104 @@
+/*
+    File:    hashcons_ast.h
+    Created: 19 October 2026 at 15:02 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef HASHCONS_AST_H
+#define HASHCONS_AST_H
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "../include/ast.h"
+#include "../include/flat_ast.h"
+namespace ast{
+    /*
+     * The class Hashcons_builder builds a DAG of regexps of all rules of a specification,
+     * in which structurally identical subtrees (with the same kinds of nodes, payloads
+     * and indices of actions) are represented by a single node. Nodes of the DAG are
+     * stored in the structure Flat_ast, and every node precedes all its parents, so that
+     * bottom-up passes over the DAG are single loops, as for a flat AST. Since every
+     * node is unique, two subexpressions are structurally equal if and only if their
+     * identifiers are equal.
+     *
+     * The hash of a node is calculated from the kind, the payload, the action and hashes
+     * of the children, but not from identifiers of nodes. Therefore, the hash does not
+     * depend on the order in which regexps are added, and is the same in all runs.
+     */
+    class Hashcons_builder{
+    public:
+        Hashcons_builder();
+        Hashcons_builder(const Hashcons_builder&) = default;
+        ~Hashcons_builder()                       = default;
+
+        /**
+         * \brief Returns the identifier of the node with the given fields. If there
+         *        is no such node, then the node is added. All children must be
+         *        identifiers of nodes of this builder.
+         */
+        uint32_t intern(Flat_kind       k,
+                        const uint32_t* children,
+                        size_t          num_of_children,
+                        uint64_t        payload,
+                        uint64_t        action);
+
+        /**
+         * \brief Adds the regexp tree to the DAG, and remembers the root of the regexp.
+         *        A node shared by several parents in the tree (for example, the body
+         *        of a rule substituted for references by Regexp_name_resolver) is
+         *        visited once, so the time is linear in the number of distinct nodes.
+         * \return The identifier of the root, or Flat_ast::no_node for an empty tree.
+         */
+        uint32_t add(const Regexp_ast& tree);
+
+        /// \brief Adds the flat AST to the DAG, as the function above.
+        uint32_t add(const Flat_ast& fa);
+
+        /**
+         * \brief Application of the action to the node id, as Ast_elem::apply_action
+         *        does: the action replaces actions of all leaves, and actions of inner
+         *        nodes are kept. The result is interned, so that subexpressions shared
+         *        by id remain shared, and the result for each pair (id, action) is
+         *        calculated once.
+         * \return The identifier of the resulting node, or Flat_ast::no_node, if id is
+         *         Flat_ast::no_node.
+         */
+        uint32_t with_action(uint32_t id, uint64_t action);
+
+        bool     equal(uint32_t a, uint32_t b) const {return a == b;};
+        uint64_t hash(uint32_t id)             const {return hashes_[id];};
+
+        const Flat_ast&              dag()   const {return dag_;};
+        const std::vector<uint32_t>& roots() const {return roots_;};
+
+        /// \brief The number of distinct subexpressions.
+        size_t number_of_nodes()       const {return dag_.size();};
+
+        /// \brief The number of subexpressions, counted with repetitions.
+        size_t number_of_occurrences() const {return num_of_occurrences_;};
+    private:
+        static constexpr uint32_t empty_slot = UINT32_MAX;
+
+        Flat_ast              dag_;
+        std::vector<uint64_t> hashes_;
+        std::vector<uint32_t> slots_;
+        std::vector<uint32_t> roots_;
+        size_t                num_of_occurrences_ = 0;
+        /* results of with_action for pairs (id, action): */
+        std::map<std::pair<uint32_t, uint64_t>, uint32_t> with_action_;
+
+        bool same_node(uint32_t        id,
+                       Flat_kind       k,
+                       const uint32_t* children,
+                       size_t          num_of_children,
+                       uint64_t        payload,
+                       uint64_t        action) const;
+        void grow();
+    };
+};
+#endif
@@ -17,9 +17,10 @@
  *  \param [in] t    pointer to prefix tree
  *  \param [in] idx  index of string in the prefix tree t
  *
- *  \return          string corresponding to the index idx
+ *  \return          string corresponding to the index idx; the UTF-8 representation
+ *                   of the string is taken from the cache of the prefix tree t
  *  */
-std::string idx_to_string(std::shared_ptr<Char_trie> t,
-                          size_t                     idx,
-                          std::string                default_value = std::string());
+std::string idx_to_string(const std::shared_ptr<Char_trie>& t,
+                          size_t                            idx,
+                          const std::string&                default_value = std::string());
 #endif
\ No newline at end of file
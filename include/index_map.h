@@ -0,0 +1,127 @@
+/*
+    File:    index_map.h
+    Created: 19 October 2026 at 11:02 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef INDEX_MAP_H
+#define INDEX_MAP_H
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <memory_resource>
+/*
+ * Keys of scopes are indices of nodes of prefix trees, i.e. small non-negative integers
+ * which are dense enough. Therefore, instead of std::map<size_t, V>, we use a flat
+ * vector of values addressed by key, together with a bitmap of present keys. Searching,
+ * inserting and updating are performed by a single access to the vector.
+ */
+template<typename V>
+class Index_map{
+public:
+    Index_map(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) :
+        values_(mr), presence_(mr) {}
+    Index_map(const Index_map&)            = default;
+    Index_map& operator=(const Index_map&) = default;
+    ~Index_map()                           = default;
+
+    /**
+     * \brief Search of the key idx.
+     * \return A pointer to the value corresponding to the key idx, if this key is in
+     *         the map, and nullptr otherwise.
+     */
+    V* find(size_t idx);
+    const V* find(size_t idx) const;
+
+    bool contains(size_t idx) const;
+
+    /**
+     * \brief If the key idx is not in the map, then this function inserts it with
+     *        the value V().
+     * \return The pair (pointer to the value corresponding to the key idx, true if
+     *         the key has been inserted by this call).
+     */
+    std::pair<V*, bool> insert_or_get(size_t idx);
+
+    V& operator[](size_t idx)
+    {
+        return *insert_or_get(idx).first;
+    }
+
+    /// \brief The number of keys in the map.
+    size_t size() const {return num_of_keys_;};
+
+    /**
+     * \brief This function calls f(key, value) for all keys of the map in
+     *        ascending order of keys.
+     */
+    template<typename F>
+    void for_each(F f) const;
+private:
+    static constexpr size_t bits_per_word = 64;
+
+    std::pmr::vector<V>        values_;
+    std::pmr::vector<uint64_t> presence_;
+    size_t                     num_of_keys_ = 0;
+
+    bool is_present(size_t idx) const
+    {
+        return (presence_[idx / bits_per_word] >> (idx % bits_per_word)) & 1;
+    }
+};
+
+template<typename V>
+V* Index_map<V>::find(size_t idx)
+{
+    return contains(idx) ? &values_[idx] : nullptr;
+}
+
+template<typename V>
+const V* Index_map<V>::find(size_t idx) const
+{
+    return contains(idx) ? &values_[idx] : nullptr;
+}
+
+template<typename V>
+bool Index_map<V>::contains(size_t idx) const
+{
+    return (idx < values_.size()) && is_present(idx);
+}
+
+template<typename V>
+std::pair<V*, bool> Index_map<V>::insert_or_get(size_t idx)
+{
+    if(idx >= values_.size()){
+        size_t new_size = std::max(idx + 1, 2 * values_.size());
+        values_.resize(new_size);
+        presence_.resize((new_size + bits_per_word - 1) / bits_per_word);
+    }
+    uint64_t& word = presence_[idx / bits_per_word];
+    uint64_t  mask = 1ULL << (idx % bits_per_word);
+    if(word & mask){
+        return std::make_pair(&values_[idx], false);
+    }
+    word |= mask;
+    num_of_keys_++;
+    return std::make_pair(&values_[idx], true);
+}
+
+template<typename V>
+template<typename F>
+void Index_map<V>::for_each(F f) const
+{
+    for(size_t w = 0; w < presence_.size(); ++w){
+        uint64_t word = presence_[w];
+        while(word){
+            size_t idx = w * bits_per_word + __builtin_ctzll(word);
+            f(idx, values_[idx]);
+            word &= word - 1;
+        }
+    }
+}
+#endif
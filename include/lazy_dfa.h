@@ -0,0 +1,112 @@
+/*
+    File:    lazy_dfa.h
+    Created: 20 October 2026 at 11:48 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef LAZY_DFA_H
+#define LAZY_DFA_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../include/dfa.h"
+#include "../include/char_classes.h"
+#include "../include/thompson_nfa.h"
+#include "../include/sparse_set.h"
+/*
+ * The class Lazy_dfa finds longest matches by the deterministic automaton equivalent to
+ * a Thompson NFA, but builds states of this automaton only when they are reached, and
+ * keeps them in a cache of bounded size. The alphabet consists of classes of equivalent
+ * characters, as for the class Subset_constructor.
+ *
+ * A cached state occupies a slot: the set of states Char and Match of the NFA, the
+ * accepted rule, and the row of transitions by all classes. The memory used by slots
+ * and sets of states does not exceed the budget given to the constructor (except for
+ * the case when the budget is too small for min_slots slots, or a single state does
+ * not fit into it). When a new state does not fit, states are evicted by the clock
+ * algorithm: the hand goes over slots, clears the bit of reference of recently used
+ * slots and evicts the first slot whose bit is already cleared.
+ *
+ * A transition stores the number of the target slot together with the generation of
+ * this slot. The generation of a slot is increased when the slot is evicted, so
+ * transitions into evicted states become invalid without visiting them; an invalid
+ * transition is computed again on demand.
+ */
+class Lazy_dfa{
+public:
+    static constexpr size_t min_slots = 4;
+
+    Lazy_dfa(const Thompson_nfa& nfa, size_t memory_budget);
+    Lazy_dfa(const Lazy_dfa&) = delete;
+    ~Lazy_dfa()               = default;
+
+    Dfa_match longest_match(const char32_t* begin, const char32_t* end);
+
+    /* Numbers of transitions found in the cache and computed again: */
+    size_t hits()                    const {return hits_;};
+    size_t misses()                  const {return misses_;};
+    size_t evictions()               const {return evictions_;};
+    size_t number_of_cached_states() const {return used_ - free_.size();};
+    size_t number_of_symbols()       const {return num_of_symbols_;};
+    size_t memory_used()             const {return used_ * slot_size_ + set_bytes_;};
+
+    void reset_counters()
+    {
+        hits_ = misses_ = evictions_ = 0;
+    }
+private:
+    static constexpr uint32_t no_slot    = UINT32_MAX;
+    static constexpr uint32_t dead_state = UINT32_MAX;
+
+    struct Transition{
+        uint32_t target_     = 0;
+        uint32_t generation_ = 0; ///< 0 for transitions which are not computed yet
+    };
+
+    const Thompson_nfa&                nfa_;
+    Char_classes                       classes_;
+    size_t                             budget_;
+    size_t                             num_of_symbols_;
+    size_t                             slot_size_;
+    size_t                             max_slots_;
+
+    /* Data of slots: */
+    std::vector<Transition>            rows_;
+    std::vector<uint32_t>              generation_;
+    std::vector<uint8_t>               referenced_;
+    std::vector<uint8_t>               live_;
+    std::vector<uint32_t>              accept_;
+    std::vector<uint64_t>              hash_;
+    std::vector<std::vector<uint32_t>> sets_;
+    std::vector<uint32_t>              free_;
+    size_t                             used_      = 0;
+    size_t                             set_bytes_ = 0;
+    size_t                             hand_      = 0;
+
+    /* The hash table of live slots, with open addressing: */
+    std::vector<uint32_t>              table_;
+
+    Transition                         start_;
+    uint32_t                           pinned_    = no_slot;
+
+    Sparse_set                         closure_;
+    std::vector<uint32_t>              stack_;
+
+    size_t                             hits_      = 0;
+    size_t                             misses_    = 0;
+    size_t                             evictions_ = 0;
+
+    uint32_t start_state();
+    uint32_t compute_transition(uint32_t s, uint32_t cls);
+    uint32_t intern_closure();
+    uint32_t new_slot(size_t set_size);
+    uint32_t choose_victim();
+    void     evict(uint32_t slot);
+    void     table_insert(uint32_t slot);
+    void     table_erase(uint32_t slot);
+    bool     same_set(uint32_t slot, size_t size) const;
+};
+#endif
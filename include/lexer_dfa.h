@@ -0,0 +1,117 @@
+/*
+    File:    lexer_dfa.h
+    Created: 20 October 2026 at 13:05 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef LEXER_DFA_H
+#define LEXER_DFA_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../include/dfa.h"
+#include "../include/regrule.h"
+#include "../include/scope.h"
+#include "../include/trie_for_set.h"
+#include "../include/errors_and_tries.h"
+
+enum class Token_kind : uint8_t{
+    Keyword, Delimiter, Rule
+};
+
+struct Lexer_token{
+    Token_kind kind_ = Token_kind::Rule;
+    /* The index of the name of the rule in the prefix tree of identifiers (Rule), or
+     * the index of the string literal in the prefix tree of strings (Keyword and
+     * Delimiter): */
+    size_t     idx_  = 0;
+    /* The lexeme code of a keyword or a delimiter: */
+    size_t     code_ = 0;
+};
+
+/* The result of the search of the next token: */
+struct Lexer_match{
+    static constexpr uint32_t no_token = UINT32_MAX;
+
+    size_t   length_ = 0;
+    uint32_t token_  = no_token; ///< the index in Lexer_dfa::tokens_, or no_token
+};
+
+/*
+ * The structure Lexer_dfa is the scanner automaton for all tokens of a language: the
+ * keywords, the delimiters, and the top-level rules. The rule accepted by a state of
+ * dfa_ is the index of the token in tokens_.
+ *
+ * A rule is top-level, i.e. is a token, if no other rule refers to it by %name. A
+ * referenced rule is a fragment of the tokens that use it: its body is expanded in
+ * their bodies, but it is not accepted by itself, so that, for example, a string
+ * literal is recognized by the rule of the whole literal rather than by the rule of
+ * its part.
+ *
+ * Tokens are numbered by priority. Keywords and delimiters go first, since a keyword
+ * is usually also matched by the rule of identifiers and must win; two literals never
+ * match the same string, so their relative order does not matter. Rules go after them
+ * in the order of declaration, so among rules matching the longest prefix, the first
+ * declared one wins.
+ *
+ * A token never matches the empty string: a scanner which accepts it at the start
+ * state would return a token of length 0 without advancing. Such a rule is reported
+ * as an error rather than kept with the start state made non-accepting, since a
+ * rule like a* would lose its non-empty matches too when the automaton returns to
+ * the start state.
+ *
+ * The automaton is built by the class Tagged_dfa_builder, so its sets of actions
+ * consist of tags make_tag(t, action), where t is the index of the token whose
+ * positions demand the action. A transition can carry actions of several tokens, and
+ * only the actions tagged with the token finally matched may be executed.
+ */
+struct Lexer_dfa{
+    Dfa                      dfa_;
+    std::vector<Lexer_token> tokens_;
+
+    /**
+     * \brief Search of the token at the beginning of the text: the longest prefix
+     *        accepted by the automaton. The automaton is walked once, and the last
+     *        accepting position is remembered, so the cost does not depend on the
+     *        number of tokens.
+     */
+    Lexer_match next_token(const char32_t* begin, const char32_t* end) const
+    {
+        Dfa_match   m = dfa_.longest_match(begin, end);
+        Lexer_match result;
+        if(m.rule_id_ != Dfa::no_state){
+            result.length_ = m.length_;
+            result.token_  = m.rule_id_;
+        }
+        return result;
+    }
+};
+
+/**
+ * \brief The name of the token t in generated code: Rule_name for a rule, and
+ *        Keyword_t or Delimiter_t for a literal, since several literals may have the
+ *        same lexeme code.
+ */
+std::string token_name(const Lexer_dfa& lexer, size_t t, const Errors_and_tries& et);
+
+/**
+ * \brief Building of the scanner automaton for the top-level rules, and for the
+ *        keywords and delimiters from scope.strsc_. References %name in the rules are
+ *        resolved by the class Regexp_name_resolver. A warning is printed for every
+ *        top-level rule which is not accepted by any state, i.e. is completely
+ *        shadowed by tokens of higher priority, and an error for every top-level
+ *        rule which matches the empty string.
+ * \return true, if there are no errors of resolution, no rules matching the empty
+ *         string and no conflicts of actions (see Tagged_dfa_builder), and false
+ *         otherwise. In the latter case, result is not changed.
+ */
+bool build_lexer_dfa(const std::vector<Rule_info>&    rules,
+                     const Scope&                     scope,
+                     const Errors_and_tries&          et,
+                     const Trie_for_set_of_char32ptr& sets,
+                     Lexer_dfa&                       result);
+#endif
@@ -0,0 +1,41 @@
+/*
+    File:    lower_rules.h
+    Created: 20 October 2026 at 09:20 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef LOWER_RULES_H
+#define LOWER_RULES_H
+#include <vector>
+#include "../include/dfa.h"
+#include "../include/regrule.h"
+#include "../include/trie_for_set.h"
+#include "../include/errors_and_tries.h"
+/**
+ * \brief Lowering of rules whose references %name are already resolved into the
+ *        minimal deterministic automaton. Each body is simplified, alternations of
+ *        literals are factored, the Thompson NFA of all rules is built and
+ *        determinized, and the result is minimized. The number of a rule in the
+ *        automaton is its index in the vector rules; if a string is matched by several
+ *        rules, the rule with the least index is accepted.
+ * \param [in] rules The rules.
+ * \param [in] sets  The prefix tree of sets of characters, to which indices of
+ *                   character classes of the rules refer.
+ */
+Dfa lower_resolved_rules(const std::vector<Rule_info>&    rules,
+                         const Trie_for_set_of_char32ptr& sets);
+
+/**
+ * \brief The same as lower_resolved_rules, but references %name in the rules are
+ *        resolved first, by the class Regexp_name_resolver.
+ * \return true, if there are no errors of resolution, and false otherwise. In the
+ *         latter case, result is not changed.
+ */
+bool lower_rules(const std::vector<Rule_info>&    rules,
+                 const Errors_and_tries&          et,
+                 const Trie_for_set_of_char32ptr& sets,
+                 Dfa&                             result);
+#endif
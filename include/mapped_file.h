@@ -0,0 +1,31 @@
+/*
+    File:    mapped_file.h
+    Created: 19 October 2026 at 10:05 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+#include <cstddef>
+/* The class Mapped_file maps the whole file into the memory for reading. The mapping
+ * is released by the destructor. */
+class Mapped_file{
+public:
+    Mapped_file() = default;
+    Mapped_file(const char* name);
+    Mapped_file(const Mapped_file&)            = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+    ~Mapped_file();
+
+    /* This function returns true, if the file is successfully mapped. */
+    bool        is_mapped() const {return data_ != nullptr;};
+    const void* data()      const {return data_;};
+    size_t      size()      const {return size_;};
+private:
+    void*  data_ = nullptr;
+    size_t size_ = 0;
+};
+#endif
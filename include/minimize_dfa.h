@@ -0,0 +1,31 @@
+/*
+    File:    minimize_dfa.h
+    Created: 20 October 2026 at 08:41 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef MINIMIZE_DFA_H
+#define MINIMIZE_DFA_H
+#include "../include/dfa.h"
+/**
+ * \brief Minimization of a deterministic automaton by the algorithm of Hopcroft in
+ *        the form of Valmari and Lehtinen, which works in time O(m log n), where m is
+ *        the number of transitions and n is the number of states.
+ *
+ *        States which are unreachable from the start state, and states from which no
+ *        accepting state is reachable, are removed first, together with transitions
+ *        leading to them. Then states are split into blocks: the initial partition
+ *        separates states accepting different rules and states whose transitions by
+ *        the same symbol execute different sets of actions, and blocks are refined
+ *        until transitions by each symbol lead from a block into one block. States of
+ *        the result are numbered in the order of breadth-first traversal from the
+ *        start state, so the start state has the number 0.
+ *
+ * \return The minimal automaton with the same alphabet. If the automaton does not
+ *         accept any string, then the start state of the result is Dfa::no_state.
+ */
+Dfa minimize(const Dfa& dfa);
+#endif
@@ -9,8 +9,35 @@
 
 #ifndef PRINT_AST_H
 #define PRINT_AST_H
+#include <cstdio>
 #include <string>
 #include <memory>
 #include "../include/ast.h"
+
+/* Formats of printing of ASTs. */
+enum class Ast_output_format{
+    Text, ///< The indented text, the same as the result of ast2string.
+    Json, ///< One JSON value per tree.
+    Dot   ///< The description of the tree as a graph for Graphviz.
+};
+
 std::string ast2string(const ast::Regexp_ast& tree);
-#endif
\ No newline at end of file
+
+/**
+ * \brief This function appends the representation of the tree in the format fmt to
+ *        the string buf. Since the string is not cleared, the same buffer can be reused
+ *        for many trees without reallocations.
+ */
+void print_ast(const ast::Regexp_ast& tree,
+               std::string&           buf,
+               Ast_output_format      fmt = Ast_output_format::Text);
+
+/**
+ * \brief This function writes the representation of the tree in the format fmt into
+ *        the file f. The output is accumulated in a buffer of bounded size, which is
+ *        written into the file when it is filled.
+ */
+void print_ast(const ast::Regexp_ast& tree,
+               FILE*                  f,
+               Ast_output_format      fmt = Ast_output_format::Text);
+#endif
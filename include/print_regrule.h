@@ -12,5 +12,9 @@
 #include <memory>
 #include "../include/regrule.h"
 #include "../include/char_trie.h"
-void print_regrule(const Rule_info& ri, const std::shared_ptr<Char_trie>& t);
+#include "../include/print_ast.h"
+/* This function prints the rule: its name and its body in the format fmt. */
+void print_regrule(const Rule_info&                  ri,
+                   const std::shared_ptr<Char_trie>& t,
+                   Ast_output_format                 fmt = Ast_output_format::Text);
 #endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+    File:    refinable_partition.h
+    Created: 20 October 2026 at 08:12 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef REFINABLE_PARTITION_H
+#define REFINABLE_PARTITION_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+/*
+ * The class Refinable_partition is a partition of the set {0, ..., n - 1} into
+ * disjoint sets, in the form of the paper
+ *      A. Valmari, P. Lehtinen. Efficient minimization of DFAs with partial transition
+ *      functions. STACS 2008.
+ * Elements of each set occupy a contiguous segment of the array elems_, and the
+ * elements of a set which are marked are moved to the beginning of its segment. The
+ * function split divides each set having marked elements into the marked and unmarked
+ * parts: the smaller part gets a new number, and the larger one keeps the old number.
+ * Marking and splitting take time proportional to the number of marked elements.
+ */
+class Refinable_partition{
+public:
+    Refinable_partition()                           = default;
+    Refinable_partition(const Refinable_partition&) = default;
+    ~Refinable_partition()                          = default;
+
+    /**
+     * \brief Builds the partition of {0, ..., n - 1}, in which the element e belongs
+     *        to the set group[e]. Numbers of groups must be less than num_of_groups;
+     *        a group without elements gives an empty set.
+     */
+    void init(const uint32_t* group, size_t n, size_t num_of_groups);
+
+    size_t   number_of_sets()           const {return first_.size();};
+    uint32_t set_of(uint32_t e)         const {return sidx_[e];};
+    uint32_t first(uint32_t s)          const {return first_[s];};
+    uint32_t end(uint32_t s)            const {return end_[s];};
+    uint32_t element(uint32_t k)        const {return elems_[k];};
+
+    /* Marks the element e. An element must not be marked twice before splitting. */
+    void mark(uint32_t e)
+    {
+        uint32_t s = sidx_[e];
+        uint32_t i = loc_[e];
+        uint32_t j = first_[s] + marked_[s];
+        elems_[i]       = elems_[j];
+        loc_[elems_[i]] = i;
+        elems_[j]       = e;
+        loc_[e]         = j;
+        if(!marked_[s]++){
+            touched_.push_back(s);
+        }
+    }
+
+    /* Splits all sets having marked elements, and unmarks all elements. */
+    void split();
+private:
+    std::vector<uint32_t> elems_;
+    std::vector<uint32_t> loc_;
+    std::vector<uint32_t> sidx_;
+    std::vector<uint32_t> first_;
+    std::vector<uint32_t> end_;
+    std::vector<uint32_t> marked_;
+    std::vector<uint32_t> touched_;
+};
+#endif
@@ -0,0 +1,90 @@
+/*
+    File:    resolve_names.h
+    Created: 19 October 2026 at 17:40 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef RESOLVE_NAMES_H
+#define RESOLVE_NAMES_H
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../include/ast.h"
+#include "../include/hashcons_ast.h"
+#include "../include/regrule.h"
+#include "../include/errors_and_tries.h"
+/*
+ * The class Regexp_name_resolver replaces references %name in bodies of rules by
+ * bodies of the rules with these names. Rules are added by the function add_rule, and
+ * then the function resolve builds the graph of references between rules, checks that
+ * all referenced rules are defined and that there are no recursive definitions, and
+ * builds the expanded bodies of all rules.
+ *
+ * Each rule is expanded only once, in such order that referenced rules are expanded
+ * before the rules referring to them. A reference is replaced by the root of the
+ * already expanded body, so that the body is shared by all references to it rather
+ * than copied, and the size of expanded bodies does not grow exponentially with the
+ * depth of nesting of definitions. If a reference carries an action (%name$action),
+ * then the body is copied once for each pair (name, action), and the action is applied
+ * to the copy. The copy is built through a DAG of ast::Hashcons_builder, so bodies of
+ * rules shared in the referenced body, as well as other identical subexpressions, are
+ * shared in the copy too, and the copy is not larger than the referenced body.
+ */
+class Regexp_name_resolver{
+public:
+    Regexp_name_resolver()                            = default;
+    Regexp_name_resolver(const Regexp_name_resolver&) = default;
+    ~Regexp_name_resolver()                           = default;
+
+    explicit Regexp_name_resolver(const Errors_and_tries& et) : et_(et) {}
+
+    /* A rule with an already added name is not added. Such a rule is diagnosed by
+     * the parser of rules (Regrule::Impl::check_rule_name), so no message is printed
+     * here, but the subsequent call of resolve fails. */
+    void add_rule(const Rule_info& ri);
+
+    /**
+     * \brief Resolution of references in all added rules. Diagnostics about undefined
+     *        and recursively defined rules are printed, and the number of errors is
+     *        increased.
+     * \return true, if there are no errors and no rule was rejected by add_rule,
+     *         and false otherwise.
+     */
+    bool resolve();
+
+    /* Expanded rules, in the same order as the rules were added. */
+    const std::vector<Rule_info>& expanded_rules() const {return expanded_;};
+
+    /* The expanded rule with the name name_idx, or nullptr if there is no such rule. */
+    const Rule_info* find_expanded(size_t name_idx) const;
+
+    /* true, if the rule with the number r (in the order of addition) is referenced by
+     * another rule; valid after a successful call of resolve. */
+    bool is_referenced(size_t r) const {return referenced_[r];};
+private:
+    Errors_and_tries                                     et_;
+    std::vector<Rule_info>                               rules_;
+    std::vector<Rule_info>                               expanded_;
+    std::unordered_map<size_t, size_t>                   rule_by_name_;
+    bool                                                 has_duplicates_ = false;
+    /* refs_[r] contains numbers of rules referenced by the rule with the number r: */
+    std::vector<std::vector<size_t>>                     refs_;
+    std::vector<uint8_t>                                 referenced_;
+    /* expanded copies of bodies with actions applied: */
+    std::map<std::pair<size_t, size_t>, ast::Regexp_ast> with_action_;
+    /* the DAG through which the copies are built: */
+    ast::Hashcons_builder                                dag_;
+
+    bool collect_references();
+    bool sort_rules(std::vector<size_t>& order);
+    void expand(size_t r);
+
+    friend class Name_expander;
+};
+#endif
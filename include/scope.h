@@ -9,7 +9,7 @@
 
 #ifndef SCOPE_H
 #define SCOPE_H
-#include <map>
+#include "../include/index_map.h"
 #include <cstddef>
 #include <cstdint>
 enum class Id_kind : uint8_t{
@@ -29,7 +29,7 @@ struct Id_attributes{
      * scanner, the name of the type of lexeme codes, the lexeme code, or the name
      * of the action, etc.
      */
-    Id_kinds kind_;
+    Id_kinds kind_     = 0;
     /**
      * The numerical value of the lexeme code, if the identifier is the lexem code.
      */
@@ -62,7 +62,7 @@ struct Str_attributes{
      * comment, the beginning of a multi-line comment, or the end of a multi-line
      * comment.
      */
-    Str_kinds kind_;
+    Str_kinds kind_ = 0;
     /**
      * The lexeme code, if the string literal is a string representation of
      * a keyword or a delimiter.
@@ -70,9 +70,9 @@ struct Str_attributes{
     size_t    code_ = 0;
 };
 
-using Id_scope  = std::map<size_t, Id_attributes>;
+using Id_scope  = Index_map<Id_attributes>;
 
-using Str_scope = std::map<size_t, Str_attributes>;
+using Str_scope = Index_map<Str_attributes>;
 
 class Scope{
 public:
@@ -81,7 +81,8 @@ public:
     /// Mapping of indeces of string literals in the attributes of string literals.
     Str_scope strsc_;
 
-    Scope()                  = default;
+    Scope(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) :
+        idsc_(mr), strsc_(mr) {}
     ~Scope()                 = default;
     Scope(const Scope& orig) = default;
 };
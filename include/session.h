@@ -0,0 +1,58 @@
+/*
+    File:    session.h
+    Created: 19 October 2026 at 12:03 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef SESSION_H
+#define SESSION_H
+#include <memory>
+#include <memory_resource>
+#include "../include/errors_and_tries.h"
+#include "../include/scope.h"
+#include "../include/trie_for_set.h"
+
+/* Kinds of memory resources of a compilation session. */
+enum class Memory_resource_kind{
+    Monotonic, ///< std::pmr::monotonic_buffer_resource; deallocation is a no-op.
+    Pool,      ///< std::pmr::unsynchronized_pool_resource.
+    Malloc     ///< std::pmr::new_delete_resource(), i.e. the ordinary heap.
+};
+
+/*
+ * The class Session owns the memory resource of a compilation, together with the
+ * objects common for all scanners and parsers: the counter of errors, the prefix
+ * trees of identifiers, of string literals and of sets of characters, and the scope.
+ * All these objects, as well as buffers of scanners and nodes of ASTs built by
+ * parsers, take memory from the resource of the session. If the resource is
+ * monotonic, then the whole memory of the compilation is freed at once when the
+ * session is destroyed.
+ *
+ * The session must outlive all scanners and parsers that use it.
+ */
+class Session{
+public:
+    explicit Session(Memory_resource_kind kind = Memory_resource_kind::Monotonic);
+    Session(const Session&)            = delete;
+    Session& operator=(const Session&) = delete;
+    ~Session();
+
+    Memory_resource_kind       kind()             const {return kind_;};
+    std::pmr::memory_resource* resource()         const {return resource_;};
+
+    const Errors_and_tries&    errors_and_tries() const {return et_;};
+    std::shared_ptr<Scope>     scope()            const {return scope_;};
+    Trie_for_set_of_char32ptr  sets_trie()        const {return sets_trie_;};
+private:
+    Memory_resource_kind                       kind_;
+    std::unique_ptr<std::pmr::memory_resource> own_resource_;
+    std::pmr::memory_resource*                 resource_;
+
+    Errors_and_tries                           et_;
+    std::shared_ptr<Scope>                     scope_;
+    Trie_for_set_of_char32ptr                  sets_trie_;
+};
+#endif
@@ -0,0 +1,35 @@
+/*
+    File:    simplify_ast.h
+    Created: 19 October 2026 at 15:48 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef SIMPLIFY_AST_H
+#define SIMPLIFY_AST_H
+#include "../include/ast.h"
+#include "../include/trie_for_set.h"
+namespace ast{
+    /**
+     * \brief Algebraic simplification of a regexp. The function performs the following
+     *        rewritings:
+     *          1) nested Concat and nested Or are flattened, and Concat or Or with one
+     *             child is replaced by this child;
+     *          2) (x*)*, (x+)*, (x?)*, (x*)+, (x?)+, (x*)?, (x+)? are replaced by x*,
+     *             (x+)+ is replaced by x+, and (x?)? is replaced by x?;
+     *          3) repeated alternatives x|x are removed;
+     *          4) all alternatives of one Or which are characters or character classes
+     *             with the same action are merged into one character class; the new set
+     *             of characters is inserted into the prefix tree sets.
+     *        Actions are preserved. The tree is not modified: new nodes are allocated
+     *        in the arena of the tree, and unchanged subtrees are shared.
+     * \param [in] tree The regexp.
+     * \param [in] sets The prefix tree of sets of characters, to which indices of
+     *                  character classes of the tree refer.
+     * \return The simplified regexp.
+     */
+    Regexp_ast simplify(const Regexp_ast& tree, Trie_for_set_of_char32& sets);
+};
+#endif
@@ -0,0 +1,172 @@
+/*
+    File:    small_vector.h
+    Created: 19 October 2026 at 13:10 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+#include <algorithm>
+/*
+ * The class Small_vector<T, N> is a vector whose first N elements are stored inside
+ * the vector itself. Only if the number of elements exceeds N, the elements are moved
+ * to a contiguous buffer taken from a memory resource. The type T must be trivially
+ * copyable (for example, a pointer), so elements are copied by memcpy.
+ */
+template<typename T, size_t N>
+class Small_vector{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Small_vector requires a trivially copyable type of elements.");
+public:
+    using value_type     = T;
+    using iterator       = T*;
+    using const_iterator = const T*;
+
+    explicit Small_vector(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) :
+        data_(inline_), size_(0), capacity_(N), mr_(mr) {}
+
+    Small_vector(const Small_vector& orig);
+    Small_vector(Small_vector&& orig) noexcept;
+    Small_vector& operator=(const Small_vector& orig);
+    Small_vector& operator=(Small_vector&& orig) noexcept;
+    ~Small_vector();
+
+    void push_back(const T& x)
+    {
+        if(size_ == capacity_){
+            reserve(2 * capacity_);
+        }
+        data_[size_++] = x;
+    }
+
+    void pop_back()                        {size_--;};
+    void clear()                           {size_ = 0;};
+    void reserve(size_t new_capacity);
+
+    size_t         size()            const {return size_;};
+    bool           empty()           const {return !size_;};
+
+    T*             data()                  {return data_;};
+    const T*       data()            const {return data_;};
+    iterator       begin()                 {return data_;};
+    iterator       end()                   {return data_ + size_;};
+    const_iterator begin()           const {return data_;};
+    const_iterator end()             const {return data_ + size_;};
+    T&             front()                 {return data_[0];};
+    const T&       front()           const {return data_[0];};
+    T&             back()                  {return data_[size_ - 1];};
+    const T&       back()            const {return data_[size_ - 1];};
+    T&             operator[](size_t i)       {return data_[i];};
+    const T&       operator[](size_t i) const {return data_[i];};
+
+    std::pmr::memory_resource* resource() const {return mr_;};
+private:
+    T*                         data_;
+    size_t                     size_;
+    size_t                     capacity_;
+    std::pmr::memory_resource* mr_;
+    T                          inline_[N];
+
+    bool is_inline() const {return data_ == inline_;};
+    void release();
+};
+
+template<typename T, size_t N>
+Small_vector<T, N>::Small_vector(const Small_vector& orig) :
+    data_(inline_), size_(0), capacity_(N), mr_(orig.mr_)
+{
+    reserve(orig.size_);
+    memcpy(data_, orig.data_, orig.size_ * sizeof(T));
+    size_ = orig.size_;
+}
+
+template<typename T, size_t N>
+Small_vector<T, N>::Small_vector(Small_vector&& orig) noexcept :
+    data_(inline_), size_(orig.size_), capacity_(N), mr_(orig.mr_)
+{
+    if(orig.is_inline()){
+        memcpy(inline_, orig.inline_, orig.size_ * sizeof(T));
+    }else{
+        data_          = orig.data_;
+        capacity_      = orig.capacity_;
+        orig.data_     = orig.inline_;
+        orig.capacity_ = N;
+    }
+    orig.size_ = 0;
+}
+
+template<typename T, size_t N>
+Small_vector<T, N>& Small_vector<T, N>::operator=(const Small_vector& orig)
+{
+    if(this != &orig){
+        size_ = 0;
+        reserve(orig.size_);
+        memcpy(data_, orig.data_, orig.size_ * sizeof(T));
+        size_ = orig.size_;
+    }
+    return *this;
+}
+
+template<typename T, size_t N>
+Small_vector<T, N>& Small_vector<T, N>::operator=(Small_vector&& orig) noexcept
+{
+    if(this == &orig){
+        return *this;
+    }
+    if(orig.is_inline() || (orig.mr_ != mr_ && !mr_->is_equal(*orig.mr_))){
+        size_ = 0;
+        reserve(orig.size_);
+        memcpy(data_, orig.data_, orig.size_ * sizeof(T));
+        size_      = orig.size_;
+        orig.size_ = 0;
+        return *this;
+    }
+    release();
+    data_          = orig.data_;
+    size_          = orig.size_;
+    capacity_      = orig.capacity_;
+    orig.data_     = orig.inline_;
+    orig.size_     = 0;
+    orig.capacity_ = N;
+    return *this;
+}
+
+template<typename T, size_t N>
+Small_vector<T, N>::~Small_vector()
+{
+    release();
+}
+
+template<typename T, size_t N>
+void Small_vector<T, N>::release()
+{
+    if(!is_inline()){
+        mr_->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+    }
+    data_     = inline_;
+    capacity_ = N;
+}
+
+template<typename T, size_t N>
+void Small_vector<T, N>::reserve(size_t new_capacity)
+{
+    if(new_capacity <= capacity_){
+        return;
+    }
+    new_capacity = std::max(new_capacity, 2 * capacity_);
+    T* p         = static_cast<T*>(mr_->allocate(new_capacity * sizeof(T), alignof(T)));
+    memcpy(p, data_, size_ * sizeof(T));
+    size_t sz    = size_;
+    release();
+    data_        = p;
+    size_        = sz;
+    capacity_    = new_capacity;
+}
+#endif
@@ -0,0 +1,74 @@
+/*
+    File:    sparse_set.h
+    Created: 19 October 2026 at 21:34 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef SPARSE_SET_H
+#define SPARSE_SET_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+/*
+ * The class Sparse_set is a set of integers from the segment [0, capacity()) in the
+ * representation of Briggs and Torczon. Elements are stored in the array dense_ in the
+ * order of insertion, and sparse_[i] is the index of i in dense_. The integer i belongs
+ * to the set if and only if sparse_[i] < size_ and dense_[sparse_[i]] == i. Hence,
+ * contents of sparse_ need not be cleared, and insertion, membership test and clearing
+ * of the set take constant time.
+ */
+class Sparse_set{
+public:
+    Sparse_set()                             = default;
+    Sparse_set(const Sparse_set&)            = default;
+    Sparse_set(Sparse_set&&)                 = default;
+    Sparse_set& operator=(const Sparse_set&) = default;
+    Sparse_set& operator=(Sparse_set&&)      = default;
+    ~Sparse_set()                            = default;
+
+    explicit Sparse_set(size_t capacity) : dense_(capacity), sparse_(capacity) {}
+
+    /* Changes the capacity; the set becomes empty. */
+    void reset(size_t capacity)
+    {
+        dense_.resize(capacity);
+        sparse_.resize(capacity);
+        size_ = 0;
+    }
+
+    size_t capacity() const {return dense_.size();};
+    size_t size()     const {return size_;};
+    bool   empty()    const {return !size_;};
+
+    bool contains(uint32_t i) const
+    {
+        uint32_t k = sparse_[i];
+        return (k < size_) && (dense_[k] == i);
+    }
+
+    /* Adds i to the set. Returns true, if i was not in the set. */
+    bool insert(uint32_t i)
+    {
+        if(contains(i)){
+            return false;
+        }
+        sparse_[i]      = static_cast<uint32_t>(size_);
+        dense_[size_++] = i;
+        return true;
+    }
+
+    void clear() {size_ = 0;};
+
+    /* Elements in the order of insertion: */
+    const uint32_t* begin()              const {return dense_.data();};
+    const uint32_t* end()                const {return dense_.data() + size_;};
+    uint32_t        operator[](size_t k) const {return dense_[k];};
+private:
+    std::vector<uint32_t> dense_;
+    std::vector<uint32_t> sparse_;
+    size_t                size_   = 0;
+};
+#endif
@@ -0,0 +1,72 @@
+/*
+    File:    subset_construction.h
+    Created: 19 October 2026 at 23:05 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef SUBSET_CONSTRUCTION_H
+#define SUBSET_CONSTRUCTION_H
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "../include/dfa.h"
+#include "../include/thompson_nfa.h"
+#include "../include/sparse_set.h"
+/*
+ * The class Subset_constructor builds the deterministic automaton equivalent to
+ * a Thompson NFA by the subset construction.
+ *
+ * The alphabet consists of the classes of equivalent characters for all labels of the
+ * NFA (see the class Char_classes), and each label is the union of the classes listed
+ * for it. Transitions of a state of the DFA are found by distributing its NFA states
+ * over buckets of classes; only the classes actually occurring are visited.
+ *
+ * A state of the DFA is the set of states Char and Match of the epsilon closure: other
+ * states do not influence further behaviour. The sets are stored one after another
+ * in one pool and are found by a hash table with open addressing. The hash of a set is
+ * the sum of hashes of its elements; it does not depend on the order of elements and is
+ * computed while the closure is being built. A candidate set is compared with a stored
+ * one by membership of stored elements in the sparse set of the closure, so sets are
+ * neither sorted nor copied unless they are new.
+ */
+class Subset_constructor{
+public:
+    explicit Subset_constructor(const Thompson_nfa& nfa);
+    Subset_constructor(const Subset_constructor&) = delete;
+    ~Subset_constructor()                         = default;
+
+    Dfa build();
+private:
+    static constexpr uint32_t empty_slot = UINT32_MAX;
+
+    const Thompson_nfa&                       nfa_;
+    Dfa                                       dfa_;
+
+    /* The set of the state i is pool_[set_begin_[i]], ..., pool_[set_begin_[i+1]-1]: */
+    std::vector<uint32_t>                     pool_;
+    std::vector<size_t>                       set_begin_;
+    std::vector<uint64_t>                     set_hash_;
+    std::vector<uint32_t>                     slots_;
+
+    Sparse_set                                closure_;
+    std::vector<uint32_t>                     stack_;
+    std::vector<std::vector<uint32_t>>        buckets_;
+    std::vector<uint32_t>                     touched_;
+    std::vector<uint64_t>                     actions_;
+    std::map<std::vector<uint64_t>, uint32_t> action_ids_;
+
+    void     build_alphabet();
+    uint32_t intern_closure();
+    uint32_t intern_actions();
+    void     add_row(uint32_t s);
+    bool     same_set(uint32_t s, size_t size) const;
+    void     grow_slots();
+};
+
+/* This function builds the deterministic automaton equivalent to the automaton nfa. */
+Dfa determinize(const Thompson_nfa& nfa);
+#endif
@@ -0,0 +1,73 @@
+/*
+    File:    table_scanner_gen.h
+    Created: 20 October 2026 at 17:40 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef TABLE_SCANNER_GEN_H
+#define TABLE_SCANNER_GEN_H
+#include <cstddef>
+#include <string>
+#include "../include/lexer_dfa.h"
+#include "../include/errors_and_tries.h"
+
+/* Sizes of the generated tables: */
+struct Table_scanner_stats{
+    size_t   num_of_states_      = 0;
+    size_t   num_of_classes_     = 0;
+    /* The number of bits of numbers of states, of indices in the comb, of tokens, and
+     * of classes: 8, 16 or 32. */
+    unsigned state_bits_         = 0;
+    unsigned index_bits_         = 0;
+    unsigned token_bits_         = 0;
+    unsigned class_bits_         = 0;
+    /* The number of bits of indices of sets of actions: */
+    unsigned set_bits_           = 0;
+    /* The number of states having a default state, and the length of the comb: */
+    size_t   num_of_defaults_    = 0;
+    size_t   comb_size_          = 0;
+    /* Sizes in bytes of the table of transitions without compression, i.e. with a
+     * row for every state, and of the compressed tables base_, default_, next_ and
+     * check_: */
+    size_t   uncompressed_bytes_ = 0;
+    size_t   compressed_bytes_   = 0;
+    /* Sizes in bytes of the table of classes with the cut index, and with the index
+     * for all code points: */
+    size_t   class_table_bytes_  = 0;
+    size_t   full_class_bytes_   = 0;
+    /* The size in bytes of the table accept_, which is the same in both cases: */
+    size_t   accept_bytes_       = 0;
+    /* The size in bytes of the tables of actions, 0 if there are no actions: */
+    size_t   action_bytes_       = 0;
+};
+
+/**
+ * \brief Generation of a table-driven scanner from the automaton lexer. The result is
+ *        the text of a header which includes the runtime header comb_scanner.h and
+ *        defines the constant name of the type Comb_tables with the tables of the
+ *        scanner, and the enum name_tables::Token of tokens.
+ *
+ *        Every state gets a default state: the state with the most similar row
+ *        among previous states whose rows have the same most frequent target, so the
+ *        row of the state keeps only the entries which differ in the target or in
+ *        the actions. Rows are placed into the comb by first fit, the longest rows
+ *        first. Numbers are stored in 8, 16 or 32 bits, as required by the sizes of
+ *        the automaton.
+ *
+ *        If transitions have actions (tags of lexer.dfa_, see lexer_dfa.h), then the
+ *        tables of actions and the enum name_tables::Action of the used actions are
+ *        generated too, and the runtime executes the actions of the found token by a
+ *        handler passed to Comb_tables::longest_match.
+ * \param [out] stats The sizes of the tables.
+ */
+std::string generate_table_scanner(const Lexer_dfa&        lexer,
+                                   const Errors_and_tries& et,
+                                   const std::string&      name,
+                                   Table_scanner_stats&    stats);
+
+/* This function prints the sizes of the tables. */
+void print_table_scanner_stats(const Table_scanner_stats& stats);
+#endif
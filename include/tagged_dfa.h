@@ -0,0 +1,130 @@
+/*
+    File:    tagged_dfa.h
+    Created: 20 October 2026 at 14:02 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef TAGGED_DFA_H
+#define TAGGED_DFA_H
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "../include/dfa.h"
+#include "../include/glushkov.h"
+#include "../include/regrule.h"
+#include "../include/trie_for_set.h"
+#include "../include/errors_and_tries.h"
+#include "../include/dense_bitset.h"
+
+/* A tag of a transition is the pair (rule, action), packed into one number: */
+inline uint64_t make_tag(uint32_t rule, uint64_t action)
+{
+    return (uint64_t{rule} << 32) | action;
+}
+
+inline uint32_t tag_rule(uint64_t tag)
+{
+    return static_cast<uint32_t>(tag >> 32);
+}
+
+inline uint64_t tag_action(uint64_t tag)
+{
+    return tag & UINT32_MAX;
+}
+
+/*
+ * The class Tagged_dfa_builder builds the deterministic automaton of rules from their
+ * position automata, so that every transition knows which positions it enters. The
+ * action of a position is executed when the character of the position is consumed;
+ * an action of an inner node applies to all leaves of the node, as by apply_action,
+ * and the outermost action wins.
+ *
+ * A state of the result is the set of positions entered by the last character, so
+ * the positions entered by a transition are exactly those of the target state. Their
+ * actions become tags of the transition: the set of actions of the transition consists
+ * of tags make_tag(rule, action), and a scanner matching the rule executes the
+ * actions tagged with this rule inline, in a single forward pass.
+ *
+ * This is possible only if all positions of a rule entered by the same input demand
+ * the same action (possibly no action). Otherwise the rule is ambiguous: whether the
+ * action must be executed depends on the rest of the input. Such conflicts are
+ * reported, with an example of the input, and the automaton is not built.
+ */
+class Tagged_dfa_builder{
+public:
+    Tagged_dfa_builder(const Errors_and_tries& et, const Trie_for_set_of_char32ptr& sets);
+    Tagged_dfa_builder(const Tagged_dfa_builder&) = delete;
+    ~Tagged_dfa_builder()                         = default;
+
+    /* Adds the rule, whose references %name must already be resolved. */
+    void add_rule(const Rule_info& ri);
+
+    /* The same for the body given as a flat tree; name is the name of the rule for
+     * diagnostics. */
+    void add_rule(const ast::Flat_ast& fa, size_t name);
+
+    /**
+     * \brief Building of the minimal tagged automaton of all added rules. If a string
+     *        is matched by several rules, then the rule added first is accepted.
+     * \return true, if there are no conflicts of actions, and false otherwise. In the
+     *         latter case, result is not changed.
+     */
+    bool build(Dfa& result);
+private:
+    struct Conflict{
+        uint32_t rule_;
+        uint64_t action1_;
+        uint64_t action2_;
+        bool operator<(const Conflict& rhs) const;
+    };
+
+    Errors_and_tries                          et_;
+    Label_table                               labels_;
+    std::vector<Position_automaton>           automata_;
+    std::vector<size_t>                       names_;
+
+    /* Data of positions of all rules; positions of the rule r are numbered from
+     * pos_begin_[r] to pos_begin_[r + 1] - 1: */
+    std::vector<uint32_t>                     pos_begin_;
+    std::vector<uint32_t>                     rule_of_;
+    std::vector<uint64_t>                     action_of_;
+    std::vector<uint8_t>                      is_last_;
+
+    Dfa                                       dfa_;
+    std::map<std::vector<uint32_t>, uint32_t> state_ids_;
+    std::vector<std::vector<uint32_t>>        states_;
+    /* The transition by which a state was reached first, to restore an example: */
+    std::vector<uint32_t>                     parent_;
+    std::vector<uint32_t>                     parent_class_;
+    std::vector<Dense_bitset>                 follow_;
+    std::vector<std::vector<uint32_t>>        buckets_;
+    std::vector<uint32_t>                     touched_;
+    std::map<std::vector<uint64_t>, uint32_t> action_ids_;
+    /* For each conflict, the transition (state, class) where it occurs first: */
+    std::map<Conflict, std::pair<uint32_t, uint32_t>> conflicts_;
+
+    void     build_alphabet();
+    uint32_t intern_state(std::vector<uint32_t>& positions, uint32_t parent,
+                          uint32_t cls);
+    uint32_t intern_tags(const std::vector<uint32_t>& positions, uint32_t s,
+                         uint32_t cls);
+    void     add_row(uint32_t s);
+    void     report_conflicts();
+};
+
+/**
+ * \brief The tagged automaton of rules whose references %name are not resolved yet:
+ *        the references are resolved by the class Regexp_name_resolver first.
+ * \return true, if there are no errors of resolution and no conflicts of actions, and
+ *         false otherwise. In the latter case, result is not changed.
+ */
+bool build_tagged_dfa(const std::vector<Rule_info>&    rules,
+                      const Errors_and_tries&          et,
+                      const Trie_for_set_of_char32ptr& sets,
+                      Dfa&                             result);
+#endif
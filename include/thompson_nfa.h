@@ -0,0 +1,129 @@
+/*
+    File:    thompson_nfa.h
+    Created: 19 October 2026 at 21:48 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef THOMPSON_NFA_H
+#define THOMPSON_NFA_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../include/ast.h"
+#include "../include/flat_ast.h"
+#include "../include/char_ranges.h"
+#include "../include/sparse_set.h"
+
+enum class Nfa_state_kind : uint8_t{
+    Char,  ///< a transition by a character from the label to out1_;
+    Split, ///< epsilon transitions to out1_ and to out2_;
+    Eps,   ///< an epsilon transition to out1_, which executes the action action_;
+    Match  ///< the accepting state of the rule with the number label_
+};
+
+struct Nfa_state{
+    Nfa_state_kind kind_   = Nfa_state_kind::Eps;
+    uint32_t       out1_   = 0;
+    uint32_t       out2_   = 0;
+    uint32_t       label_  = 0; ///< the label (Char) or the number of the rule (Match)
+    uint64_t       action_ = 0;
+};
+
+/*
+ * The class Thompson_nfa is a non-deterministic finite automaton built by Thompson's
+ * construction. All states are stored in one array and refer to each other by indices.
+ * Several rules can be added into the same automaton: the start state then has epsilon
+ * transitions to start states of all rules, and each rule has its own accepting state
+ * marked by the number of the rule.
+ *
+ * An action of a leaf is stored in the state Char of this leaf. An action of an inner
+ * node is stored in a state Eps appended to the fragment of the node, so the action
+ * is executed when the subexpression has been matched.
+ */
+class Thompson_nfa{
+public:
+    static constexpr uint32_t no_state = UINT32_MAX;
+
+    Thompson_nfa()                    = default;
+    Thompson_nfa(const Thompson_nfa&) = default;
+    Thompson_nfa(Thompson_nfa&&)      = default;
+    ~Thompson_nfa()                   = default;
+
+    explicit Thompson_nfa(Label_table& labels) : labels_(&labels) {}
+
+    /**
+     * \brief Adds the rule with the number rule_id. The time of construction is linear
+     *        in the size of the tree.
+     * \return The start state of the rule.
+     */
+    uint32_t add_rule(const ast::Flat_ast& fa, uint32_t rule_id);
+    uint32_t add_rule(const ast::Regexp_ast& tree, uint32_t rule_id);
+
+    uint32_t           start()             const {return start_;};
+    size_t             size()              const {return states_.size();};
+    const Nfa_state&   state(uint32_t s)   const {return states_[s];};
+    const Label_table& labels()            const {return *labels_;};
+
+    /* Labels of all states Char, without repetitions: */
+    std::vector<uint32_t> used_labels() const;
+
+    /**
+     * \brief Adds to the set the state s and all states reachable from s by epsilon
+     *        transitions. The vector stack is used as the stack of the traversal; it is
+     *        passed by the caller so that its memory is reused.
+     */
+    void add_closure(uint32_t s, Sparse_set& set, std::vector<uint32_t>& stack) const;
+private:
+    /* An unpatched out-field of a state is identified by the number 2 * s + k, where s
+     * is the state and k is 0 for out1_ and 1 for out2_. Unpatched fields of a fragment
+     * are linked into a list through these fields themselves. */
+    struct Fragment{
+        uint32_t start_;
+        uint32_t head_;
+        uint32_t tail_;
+    };
+
+    Label_table*           labels_ = nullptr;
+    std::vector<Nfa_state> states_;
+    std::vector<Fragment>  fragments_;
+    uint32_t               start_  = no_state;
+
+    uint32_t  new_state(Nfa_state_kind k, uint32_t label, uint64_t action);
+    uint32_t& field(uint32_t slot);
+    void      patch(const Fragment& f, uint32_t target);
+    Fragment  join(const Fragment& a, const Fragment& b);
+    Fragment  single(uint32_t s, uint32_t k);
+    void      build_node(const ast::Flat_ast& fa, uint32_t i);
+};
+
+/* The result of the search of the longest match: */
+struct Nfa_match{
+    size_t   length_  = 0;
+    uint32_t rule_id_ = Thompson_nfa::no_state; ///< no_state, if there is no match
+};
+
+/*
+ * The class Nfa_simulator finds the longest prefix of a string matched by one of the
+ * rules of the automaton. If the prefix is matched by several rules, then the rule with
+ * the least number is chosen. The simulation keeps two sets of current states as sparse
+ * sets, so the transition to the next character does not allocate memory.
+ */
+class Nfa_simulator{
+public:
+    explicit Nfa_simulator(const Thompson_nfa& nfa);
+    Nfa_simulator(const Nfa_simulator&) = default;
+    ~Nfa_simulator()                    = default;
+
+    Nfa_match longest_match(const char32_t* begin, const char32_t* end);
+private:
+    const Thompson_nfa&   nfa_;
+    Sparse_set            current_;
+    Sparse_set            next_;
+    std::vector<uint32_t> stack_;
+
+    uint32_t accepted_rule() const;
+};
+#endif
@@ -16,11 +16,16 @@
 #include <algorithm>
 #include <string>
 #include <set>
+#include <string_view>
+#include <memory_resource>
+
+template<typename T>
+class Trie_image;
 
 template<typename T>
 class Trie {
 public:
-    Trie<T>();
+    Trie<T>(std::pmr::memory_resource* mr = std::pmr::get_default_resource());
 
     virtual ~Trie<T>()        = default;
 
@@ -31,7 +36,7 @@ public:
      * \param [in] s Inserted string s.
      * \return       Index of the string s in the prefix tree.
      */
-    size_t insert(const std::basic_string<T>& s);
+    size_t insert(std::basic_string_view<T> s);
 
     /**
      * \brief Calculation of the maximum degree of the vertices of the prefix tree
@@ -40,7 +45,12 @@ public:
      *         (the root of the tree is not taken into account)
      */
     size_t maximal_degree();
+
+    /// \brief The number of nodes of the prefix tree (the root is taken into account).
+    size_t number_of_nodes() const;
 protected:
+    friend class Trie_image<T>;
+
     /**
      * \struct node
      * \brief Node type of the prefix tree.
@@ -74,8 +84,8 @@ protected:
       }
     };
 
-    std::vector<node>   node_buffer;
-    std::vector<size_t> nodes_indeces;
+    std::pmr::vector<node>   node_buffer;
+    std::pmr::vector<size_t> nodes_indeces;
 
     /**
      * \brief This function adds a node marked with a value of x of type T to the list of
@@ -88,13 +98,15 @@ protected:
 
     /// \brief This function performs (possibly necessary) actions after the last
     /// character is inserted.
-    virtual void post_action(const std::basic_string<T>& s, size_t n){ };
+    virtual void post_action(std::basic_string_view<T> s, size_t n){ };
+
+    /// \brief This function is called after the whole contents of the prefix tree
+    /// has been replaced, for example, by loading from a binary image.
+    virtual void contents_replaced(){ };
 };
 
 template<typename T>
-Trie<T>::Trie(){
-    node_buffer   = std::vector<node>(1);
-    nodes_indeces = std::vector<size_t>();
+Trie<T>::Trie(std::pmr::memory_resource* mr) : node_buffer(1, mr), nodes_indeces(mr){
 }
 
 template<typename T>
@@ -107,6 +119,11 @@ size_t Trie<T>::maximal_degree(){
     return deg;
 }
 
+template<typename T>
+size_t Trie<T>::number_of_nodes() const{
+    return node_buffer.size();
+}
+
 template<typename T>
 size_t Trie<T>::add_child(size_t parent_idx, T x){
     size_t current, previous;
@@ -149,7 +166,7 @@ size_t Trie<T>::add_child(size_t parent_idx, T x){
 }
 
 template<typename T>
-size_t Trie<T>::insert(const std::basic_string<T>& s){
+size_t Trie<T>::insert(std::basic_string_view<T> s){
     ssize_t len = s.length();
     size_t current_root = 0;
     for (ssize_t i = 0; i < len; i++) {
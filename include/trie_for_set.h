@@ -18,7 +18,8 @@ template<typename T>
 class Trie_for_set : public Trie<T>{
 public:
     virtual ~Trie_for_set<T>() { };
-    Trie_for_set<T>()                            = default;
+    Trie_for_set<T>(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) :
+        Trie<T>(mr) {}
     Trie_for_set<T>(const Trie_for_set<T>& orig) = default;
 
     /**
@@ -30,7 +31,7 @@ public:
     std::set<T> get_set(size_t idx);
     size_t insertSet(const std::set<T>& s);
 private:
-    virtual void post_action(const std::basic_string<T>& s, size_t n);
+    virtual void post_action(std::basic_string_view<T> s, size_t n);
 };
 
 template<typename T>
@@ -44,7 +45,7 @@ std::set<T> Trie_for_set<T>::get_set(size_t idx){
 }
 
 template<typename T>
-void Trie_for_set<T>::post_action(const std::basic_string<T>& s, size_t n){
+void Trie_for_set<T>::post_action(std::basic_string_view<T> s, size_t n){
 }
 
 template<typename T>
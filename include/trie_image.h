@@ -0,0 +1,330 @@
+/*
+    File:    trie_image.h
+    Created: 19 October 2026 at 10:20 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#ifndef TRIE_IMAGE_H
+#define TRIE_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <utility>
+#include "../include/trie.h"
+#include "../include/mapped_file.h"
+
+/*
+ * A binary image of a prefix tree is a flat sequence of bytes which consists of
+ *      1) the header (the structure Trie_image_header);
+ *      2) the array of nodes (the structures Trie_image_node), in the same order as in
+ *         the field node_buffer of the prefix tree;
+ *      3) the array of indices of inserted strings (values of the type uint64_t), in
+ *         the same order as in the field nodes_indeces of the prefix tree.
+ * All fields have fixed sizes and are written in the native byte order, which is
+ * checked by the field byte_order_ of the header. Since indices of nodes in the image
+ * coincide with indices of nodes in the prefix tree, the image can be used in place,
+ * for example, after mapping of a file into memory, without deserialization.
+ */
+
+constexpr uint32_t trie_image_version    = 1;
+constexpr uint32_t trie_image_byte_order = 0x01020304;
+
+struct Trie_image_header{
+    char     magic_[8];
+    uint32_t version_;
+    uint32_t byte_order_;
+    uint32_t char_size_;
+    uint32_t reserved_;
+    uint64_t num_of_nodes_;
+    uint64_t num_of_indices_;
+};
+
+struct Trie_image_node{
+    uint64_t parent_;
+    uint64_t first_child_;
+    uint64_t next_;
+    uint64_t path_len_;
+    uint64_t degree_;
+    uint64_t c_;
+};
+
+constexpr char trie_image_magic[8] = {'R', 'E', 'G', 'T', 'R', 'I', 'E', 0};
+
+/* The class Trie_image is a read-only view of a binary image of a prefix tree. The
+ * view does not own the memory of the image. */
+template<typename T>
+class Trie_image{
+public:
+    Trie_image()                  = default;
+    Trie_image(const Trie_image&) = default;
+    ~Trie_image()                 = default;
+
+    /**
+     * \brief Creates a view of the image located at the memory [data, data + size).
+     *        If the memory does not contain a correct image of a prefix tree with
+     *        values of the type T, including links of nodes which do not form such a
+     *        tree, then the view is invalid.
+     */
+    Trie_image(const void* data, size_t size);
+
+    bool   is_valid()        const {return nodes_ != nullptr;};
+    size_t number_of_nodes() const {return num_of_nodes_;};
+
+    /* Using index idx, this function builds a string corresponding to the index idx. */
+    std::basic_string<T> get_string(size_t idx) const;
+
+    /* The following function returns the length of the string
+     * corresponding to the index idx. */
+    size_t get_length(size_t idx) const;
+
+    /**
+     * \brief Search of the string s in the image.
+     * \return The pair (true, index of s), if the prefix tree contains a path labeled
+     *         by s, and (false, 0) otherwise.
+     */
+    std::pair<bool, size_t> find(const std::basic_string<T>& s) const;
+
+    /* The same as Trie_for_set<T>::get_set, but for the image. */
+    std::set<T> get_set(size_t idx) const;
+
+    /**
+     * \brief This function replaces the contents of the prefix tree t by the contents
+     *        of the image. After loading, insertions into t can be continued.
+     */
+    void load_into(Trie<T>& t) const;
+
+    /* This function builds the binary image of the prefix tree t. */
+    static std::string build(const Trie<T>& t);
+
+    /**
+     * \brief This function writes the binary image of the prefix tree t into the file
+     *        with the name file_name.
+     * \return true, if the image is successfully written, and false otherwise.
+     */
+    static bool save(const Trie<T>& t, const char* file_name);
+private:
+    const Trie_image_node* nodes_          = nullptr;
+    const uint64_t*        indices_        = nullptr;
+    size_t                 num_of_nodes_   = 0;
+    size_t                 num_of_indices_ = 0;
+
+    bool links_are_correct() const;
+};
+
+template<typename T>
+Trie_image<T>::Trie_image(const void* data, size_t size)
+{
+    if(!data || (size < sizeof(Trie_image_header))){
+        return;
+    }
+    auto hdr = static_cast<const Trie_image_header*>(data);
+    if(memcmp(hdr->magic_, trie_image_magic, sizeof(trie_image_magic)) ||
+       (hdr->version_    != trie_image_version)                        ||
+       (hdr->byte_order_ != trie_image_byte_order)                     ||
+       (hdr->char_size_  != sizeof(T))                                 ||
+       !hdr->num_of_nodes_)
+    {
+        return;
+    }
+    /* The sizes of the arrays are compared with the remaining size of the memory by
+     * division, since their products with sizes of elements can overflow. */
+    size_t rest = size - sizeof(Trie_image_header);
+    if(hdr->num_of_nodes_ > rest / sizeof(Trie_image_node)){
+        return;
+    }
+    rest -= hdr->num_of_nodes_ * sizeof(Trie_image_node);
+    if(hdr->num_of_indices_ > rest / sizeof(uint64_t)){
+        return;
+    }
+    auto p          = static_cast<const char*>(data) + sizeof(Trie_image_header);
+    nodes_          = reinterpret_cast<const Trie_image_node*>(p);
+    p              += hdr->num_of_nodes_ * sizeof(Trie_image_node);
+    indices_        = reinterpret_cast<const uint64_t*>(p);
+    num_of_nodes_   = hdr->num_of_nodes_;
+    num_of_indices_ = hdr->num_of_indices_;
+    if(!links_are_correct()){
+        nodes_          = nullptr;
+        indices_        = nullptr;
+        num_of_nodes_   = 0;
+        num_of_indices_ = 0;
+    }
+}
+
+/*
+ * Links of nodes are checked as they are built by Trie<T>::add_child: a child is
+ * appended after its parent and after its elder siblings, and the length of its path
+ * is greater by one than the length of the path of the parent. Therefore the walks
+ * up to the root and along lists of children terminate, and get_string writes
+ * exactly path_len_ characters.
+ */
+template<typename T>
+bool Trie_image<T>::links_are_correct() const
+{
+    const auto& root = nodes_[0];
+    if(root.parent_ || root.next_ || root.path_len_){
+        return false;
+    }
+    for(size_t i = 0; i < num_of_nodes_; ++i){
+        const auto& n = nodes_[i];
+        if((n.first_child_ >= num_of_nodes_) || (n.next_ >= num_of_nodes_)){
+            return false;
+        }
+        if(n.first_child_ &&
+           ((n.first_child_ <= i) || (nodes_[n.first_child_].parent_ != i)))
+        {
+            return false;
+        }
+        if(!i){
+            continue;
+        }
+        if((n.parent_ >= i) || (n.path_len_ != nodes_[n.parent_].path_len_ + 1)){
+            return false;
+        }
+        if(n.next_ && ((n.next_ <= i) || (nodes_[n.next_].parent_ != n.parent_))){
+            return false;
+        }
+    }
+    for(size_t j = 0; j < num_of_indices_; ++j){
+        if(indices_[j] >= num_of_nodes_){
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+std::basic_string<T> Trie_image<T>::get_string(size_t idx) const
+{
+    size_t               len = nodes_[idx].path_len_;
+    std::basic_string<T> s(len, T());
+    for(size_t current = idx; current; current = nodes_[current].parent_){
+        s[--len] = static_cast<T>(nodes_[current].c_);
+    }
+    return s;
+}
+
+template<typename T>
+size_t Trie_image<T>::get_length(size_t idx) const
+{
+    return nodes_[idx].path_len_;
+}
+
+template<typename T>
+std::pair<bool, size_t> Trie_image<T>::find(const std::basic_string<T>& s) const
+{
+    size_t current = 0;
+    for(T x : s){
+        size_t child = nodes_[current].first_child_;
+        while(child && (static_cast<T>(nodes_[child].c_) != x)){
+            child = nodes_[child].next_;
+        }
+        if(!child){
+            return std::make_pair(false, static_cast<size_t>(0));
+        }
+        current = child;
+    }
+    return std::make_pair(true, current);
+}
+
+template<typename T>
+std::set<T> Trie_image<T>::get_set(size_t idx) const
+{
+    std::set<T> s;
+    for(size_t current = idx; current; current = nodes_[current].parent_){
+        s.insert(static_cast<T>(nodes_[current].c_));
+    }
+    return s;
+}
+
+template<typename T>
+void Trie_image<T>::load_into(Trie<T>& t) const
+{
+    t.node_buffer.resize(num_of_nodes_);
+    for(size_t i = 0; i < num_of_nodes_; ++i){
+        auto&       dst = t.node_buffer[i];
+        const auto& src = nodes_[i];
+        dst.parent      = src.parent_;
+        dst.first_child = src.first_child_;
+        dst.next        = src.next_;
+        dst.path_len    = src.path_len_;
+        dst.degree      = src.degree_;
+        dst.c           = static_cast<T>(src.c_);
+    }
+    t.nodes_indeces.assign(indices_, indices_ + num_of_indices_);
+    t.contents_replaced();
+}
+
+template<typename T>
+std::string Trie_image<T>::build(const Trie<T>& t)
+{
+    Trie_image_header hdr;
+    memcpy(hdr.magic_, trie_image_magic, sizeof(trie_image_magic));
+    hdr.version_        = trie_image_version;
+    hdr.byte_order_     = trie_image_byte_order;
+    hdr.char_size_      = sizeof(T);
+    hdr.reserved_       = 0;
+    hdr.num_of_nodes_   = t.node_buffer.size();
+    hdr.num_of_indices_ = t.nodes_indeces.size();
+
+    std::string result;
+    result.reserve(sizeof(hdr)                                 +
+                   hdr.num_of_nodes_   * sizeof(Trie_image_node) +
+                   hdr.num_of_indices_ * sizeof(uint64_t));
+    result.append(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    for(const auto& n : t.node_buffer){
+        Trie_image_node img;
+        img.parent_      = n.parent;
+        img.first_child_ = n.first_child;
+        img.next_        = n.next;
+        img.path_len_    = n.path_len;
+        img.degree_      = n.degree;
+        img.c_           = static_cast<uint64_t>(n.c);
+        result.append(reinterpret_cast<const char*>(&img), sizeof(img));
+    }
+    for(size_t idx : t.nodes_indeces){
+        uint64_t x = idx;
+        result.append(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+    return result;
+}
+
+template<typename T>
+bool Trie_image<T>::save(const Trie<T>& t, const char* file_name)
+{
+    auto  bytes = build(t);
+    FILE* fptr  = fopen(file_name, "wb");
+    if(!fptr){
+        return false;
+    }
+    size_t written = fwrite(bytes.data(), 1, bytes.size(), fptr);
+    bool   closed  = fclose(fptr) == 0;
+    return closed && (written == bytes.size());
+}
+
+/* The class Mapped_trie_image maps the file with a binary image of a prefix tree into
+ * memory and provides the view of this image. */
+template<typename T>
+class Mapped_trie_image{
+public:
+    Mapped_trie_image(const char* file_name) :
+        file_(file_name), image_(file_.data(), file_.size()) {}
+    Mapped_trie_image(const Mapped_trie_image&) = delete;
+    ~Mapped_trie_image()                        = default;
+
+    bool                 is_valid() const {return image_.is_valid();};
+    const Trie_image<T>& image()    const {return image_;};
+private:
+    Mapped_file   file_;
+    Trie_image<T> image_;
+};
+
+using Char_trie_image        = Trie_image<char32_t>;
+using Mapped_char_trie_image = Mapped_trie_image<char32_t>;
+#endif
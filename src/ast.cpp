@@ -41,51 +41,4 @@ namespace ast{
     {
         action_idx_ = act_idx;
     }
-
-    class Deleter : public Visitor{
-    public:
-        Deleter()               = default;
-        Deleter(const Deleter&) = default;
-        virtual ~Deleter()      = default;
-
-        void visit(ast::Binary_op&             ref) override;
-        void visit(ast::Unary_op&              ref) override;
-        void visit(ast::Regexp_name_leaf&      ref) override;
-        void visit(ast::Character_leaf&        ref) override;
-        void visit(ast::Char_class_leaf&       ref) override;
-        void visit(ast::Char_class_compl_leaf& ref) override;
-    };
-
-    void Deleter::visit(ast::Binary_op& ref){
-        for(auto& child : ref.children_){
-            if(child){
-                child->accept(*this);
-                child = nullptr;
-            }
-        }
-    }
-
-    void Deleter::visit(ast::Unary_op& ref){
-        auto& child =  ref.child_;
-        if(child){
-            child->accept(*this);
-            child = nullptr;
-        }
-    }
-
-    void Deleter::visit(ast::Regexp_name_leaf& ref){}
-
-    void Deleter::visit(ast::Character_leaf& ref){}
-
-    void Deleter::visit(ast::Char_class_leaf& ref){}
-
-    void Deleter::visit(ast::Char_class_compl_leaf& ref){}
-
-    Regexp_ast::~Regexp_ast()
-    {
-        if(root_){
-            Deleter d;
-            root_->accept(d);
-        }
-    }
 };
\ No newline at end of file
@@ -0,0 +1,379 @@
+/*
+    File:    ast_serialization.cpp
+    Created: 19 October 2026 at 18:58 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include "../include/ast_serialization.h"
+
+namespace ast{
+    static constexpr char     magic[]        = {'R', 'G', 'A', 'S', 'T'};
+    static constexpr uint64_t format_version = 1;
+    static constexpr uint8_t  empty_body     = 0x7F;
+    static constexpr uint8_t  action_flag    = 0x80;
+    static constexpr uint8_t  num_of_kinds   = 9;
+
+    static void put_varint(std::string& out, uint64_t x)
+    {
+        while(x >= 0x80){
+            out += static_cast<char>((x & 0x7F) | 0x80);
+            x  >>= 7;
+        }
+        out += static_cast<char>(x);
+    }
+
+    static bool has_children(Flat_kind k)
+    {
+        return (k == Flat_kind::Or)     || (k == Flat_kind::Concat)   ||
+               (k == Flat_kind::Kleene) || (k == Flat_kind::Positive) ||
+               (k == Flat_kind::Optional);
+    }
+
+    static bool is_binary(Flat_kind k)
+    {
+        return (k == Flat_kind::Or) || (k == Flat_kind::Concat);
+    }
+
+    static void put_body(std::string& out, const Flat_ast& fa)
+    {
+        if(fa.empty()){
+            out += static_cast<char>(empty_body);
+            return;
+        }
+        std::vector<uint32_t> stack{fa.root()};
+        while(!stack.empty()){
+            uint32_t  i = stack.back();
+            stack.pop_back();
+            Flat_kind k = fa.kind(i);
+            uint8_t   t = static_cast<uint8_t>(k) | (fa.actions_[i] ? action_flag : 0);
+            out        += static_cast<char>(t);
+            if(fa.actions_[i]){
+                put_varint(out, fa.actions_[i]);
+            }
+            if(is_binary(k)){
+                put_varint(out, fa.num_of_children_[i]);
+            }else if(!has_children(k)){
+                put_varint(out, fa.payloads_[i]);
+            }
+            for(const uint32_t* c = fa.children_end(i); c != fa.children_begin(i); ){
+                stack.push_back(*--c);
+            }
+        }
+    }
+
+    std::string serialize_rules(const std::vector<Rule_info>& rules,
+                                const Errors_and_tries&       et,
+                                Trie_for_set_of_char32&       sets)
+    {
+        std::vector<Flat_ast> bodies;
+        std::set<size_t>      ids;
+        std::set<size_t>      set_indices;
+        for(const auto& ri : rules){
+            bodies.push_back(to_flat(ri.body_));
+            const auto& fa = bodies.back();
+            ids.insert(ri.name_);
+            for(uint32_t i = 0; i < fa.size(); ++i){
+                if(fa.actions_[i]){
+                    ids.insert(fa.actions_[i]);
+                }
+                switch(fa.kind(i)){
+                    case Flat_kind::Regexp_name:
+                        ids.insert(fa.payloads_[i]);
+                        break;
+                    case Flat_kind::Char_class: case Flat_kind::Char_class_compl:
+                        set_indices.insert(fa.payloads_[i]);
+                        break;
+                    default:
+                        ;
+                }
+            }
+        }
+
+        std::string out(magic, sizeof(magic));
+        put_varint(out, format_version);
+
+        put_varint(out, ids.size());
+        for(size_t idx : ids){
+            auto s = et.ids_trie->get_string(idx);
+            put_varint(out, idx);
+            put_varint(out, s.length());
+            for(char32_t c : s){
+                put_varint(out, c);
+            }
+        }
+
+        put_varint(out, set_indices.size());
+        for(size_t idx : set_indices){
+            auto s = sets.get_set(idx);
+            put_varint(out, idx);
+            put_varint(out, s.size());
+            char32_t prev = 0;
+            for(char32_t c : s){
+                put_varint(out, c - prev);
+                prev = c;
+            }
+        }
+
+        put_varint(out, rules.size());
+        for(size_t r = 0; r < rules.size(); ++r){
+            put_varint(out, rules[r].name_);
+            put_body(out, bodies[r]);
+        }
+        return out;
+    }
+
+    /* Reading of the binary representation. After an error all functions fail. */
+    class Reader{
+    public:
+        Reader(std::string_view bytes) :
+            p_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+        bool ok() const {return ok_;};
+
+        uint8_t get_byte()
+        {
+            if(!ok_ || (p_ == end_)){
+                ok_ = false;
+                return 0;
+            }
+            return static_cast<uint8_t>(*p_++);
+        }
+
+        uint64_t get_varint()
+        {
+            uint64_t result = 0;
+            for(unsigned shift = 0; ok_ && (shift < 64); shift += 7){
+                uint8_t b = get_byte();
+                result   |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if(!(b & 0x80)){
+                    return result;
+                }
+            }
+            ok_ = false;
+            return 0;
+        }
+
+        /* The number of bytes which are not read yet. */
+        size_t rest() const {return end_ - p_;};
+    private:
+        const char* p_;
+        const char* end_;
+        bool        ok_ = true;
+    };
+
+    using Index_mapping = std::unordered_map<uint64_t, uint64_t>;
+
+    static bool map_index(const Index_mapping& m, uint64_t& idx)
+    {
+        auto it = m.find(idx);
+        if(it == m.end()){
+            return false;
+        }
+        idx = it->second;
+        return true;
+    }
+
+    struct Pending_node{
+        Flat_kind kind_;
+        uint64_t  action_;
+        uint64_t  num_of_children_;
+        size_t    first_id_;
+    };
+
+    /*
+     * The body is written in pre-order, and the flat AST is built in post-order: a node
+     * with children is kept in the stack of pending nodes until all its children are
+     * added, and identifiers of added children are accumulated in the stack
+     * children_ids.
+     */
+    static bool get_body(Reader&              rd,
+                         const Index_mapping& ids,
+                         const Index_mapping& set_indices,
+                         Flat_ast&            fa)
+    {
+        std::vector<Pending_node> pending;
+        std::vector<uint32_t>     children_ids;
+        fa.clear();
+        do{
+            uint8_t  t      = rd.get_byte();
+            uint8_t  kind   = t & ~action_flag;
+            uint64_t action = (t & action_flag) ? rd.get_varint() : 0;
+            if(!rd.ok()){
+                return false;
+            }
+            if(kind == empty_body){
+                return pending.empty() && !action;
+            }
+            if((kind >= num_of_kinds) || (action && !map_index(ids, action))){
+                return false;
+            }
+            Flat_kind k = static_cast<Flat_kind>(kind);
+            if(has_children(k)){
+                uint64_t n = is_binary(k) ? rd.get_varint() : 1;
+                if(!rd.ok() || !n || (n > rd.rest())){
+                    return false;
+                }
+                pending.push_back(Pending_node{k, action, n, children_ids.size()});
+                continue;
+            }
+            uint64_t payload = rd.get_varint();
+            bool     mapped  = true;
+            if(k == Flat_kind::Regexp_name){
+                mapped = map_index(ids, payload);
+            }else if(k != Flat_kind::Character){
+                mapped = map_index(set_indices, payload);
+            }
+            if(!rd.ok() || !mapped){
+                return false;
+            }
+            children_ids.push_back(fa.add_node(k, nullptr, 0, payload, action));
+            while(!pending.empty() &&
+                  (children_ids.size() - pending.back().first_id_ ==
+                   pending.back().num_of_children_))
+            {
+                auto     pn = pending.back();
+                uint32_t id = fa.add_node(pn.kind_,
+                                          children_ids.data() + pn.first_id_,
+                                          pn.num_of_children_,
+                                          0,
+                                          pn.action_);
+                children_ids.resize(pn.first_id_);
+                children_ids.push_back(id);
+                pending.pop_back();
+            }
+        }while(!pending.empty());
+        return true;
+    }
+
+    /* Replacement of indices of the binary representation in the body by indices of
+     * the prefix trees. */
+    static void remap_body(const Index_mapping& ids,
+                           const Index_mapping& set_indices,
+                           Flat_ast&            fa)
+    {
+        for(uint32_t i = 0; i < fa.size(); ++i){
+            if(fa.actions_[i]){
+                map_index(ids, fa.actions_[i]);
+            }
+            switch(fa.kind(i)){
+                case Flat_kind::Regexp_name:
+                    map_index(ids, fa.payloads_[i]);
+                    break;
+                case Flat_kind::Char_class: case Flat_kind::Char_class_compl:
+                    map_index(set_indices, fa.payloads_[i]);
+                    break;
+                default:
+                    ;
+            }
+        }
+    }
+
+    /*
+     * The whole representation is read and checked before anything is inserted into the
+     * prefix trees, so that an incorrect representation leaves them unchanged. While
+     * reading, an index of the representation is mapped to itself, i.e. the mappings
+     * only tell which indices are defined by the tables. After the check, the texts
+     * are inserted into the prefix trees and the indices in the bodies are replaced.
+     */
+    bool deserialize_rules(std::string_view             bytes,
+                           const Errors_and_tries&      et,
+                           Trie_for_set_of_char32&      sets,
+                           std::vector<Flat_rule_info>& rules)
+    {
+        Reader rd(bytes);
+        for(char c : magic){
+            if(rd.get_byte() != static_cast<uint8_t>(c)){
+                return false;
+            }
+        }
+        if(rd.get_varint() != format_version){
+            return false;
+        }
+
+        Index_mapping                                    ids;
+        std::vector<std::pair<uint64_t, std::u32string>> id_texts;
+        uint64_t                                         num_of_ids = rd.get_varint();
+        for(uint64_t i = 0; rd.ok() && (i < num_of_ids); ++i){
+            uint64_t       idx = rd.get_varint();
+            uint64_t       len = rd.get_varint();
+            std::u32string s;
+            for(uint64_t j = 0; rd.ok() && (j < len); ++j){
+                s += static_cast<char32_t>(rd.get_varint());
+            }
+            ids[idx] = idx;
+            id_texts.push_back(std::make_pair(idx, std::move(s)));
+        }
+
+        Index_mapping                                        set_indices;
+        std::vector<std::pair<uint64_t, std::set<char32_t>>> set_texts;
+        uint64_t                                             num_of_sets = rd.get_varint();
+        for(uint64_t i = 0; rd.ok() && (i < num_of_sets); ++i){
+            uint64_t           idx  = rd.get_varint();
+            uint64_t           len  = rd.get_varint();
+            char32_t           prev = 0;
+            std::set<char32_t> s;
+            for(uint64_t j = 0; rd.ok() && (j < len); ++j){
+                prev += static_cast<char32_t>(rd.get_varint());
+                s.insert(prev);
+            }
+            set_indices[idx] = idx;
+            set_texts.push_back(std::make_pair(idx, std::move(s)));
+        }
+
+        uint64_t num_of_rules = rd.get_varint();
+        if(!rd.ok() || (num_of_rules > rd.rest())){
+            return false;
+        }
+        std::vector<Flat_rule_info> loaded(num_of_rules);
+        for(auto& r : loaded){
+            uint64_t name = rd.get_varint();
+            if(!rd.ok() || !map_index(ids, name) ||
+               !get_body(rd, ids, set_indices, r.body_))
+            {
+                return false;
+            }
+            r.name_ = name;
+        }
+        if(!rd.ok() || rd.rest()){
+            return false;
+        }
+
+        for(const auto& t : id_texts){
+            ids[t.first] = et.ids_trie->insert(t.second);
+        }
+        for(const auto& t : set_texts){
+            set_indices[t.first] = sets.insertSet(t.second);
+        }
+        for(auto& r : loaded){
+            uint64_t name = r.name_;
+            map_index(ids, name);
+            r.name_ = name;
+            remap_body(ids, set_indices, r.body_);
+        }
+        rules = std::move(loaded);
+        return true;
+    }
+
+    bool deserialize_rules(std::string_view             bytes,
+                           const Errors_and_tries&      et,
+                           Trie_for_set_of_char32&      sets,
+                           std::vector<Rule_info>&      rules)
+    {
+        std::vector<Flat_rule_info> flat_rules;
+        if(!deserialize_rules(bytes, et, sets, flat_rules)){
+            return false;
+        }
+        rules.clear();
+        for(const auto& fr : flat_rules){
+            rules.push_back(Rule_info{fr.name_, from_flat(fr.body_, et.memory_resource)});
+        }
+        return true;
+    }
+};
@@ -0,0 +1,154 @@
+/*
+    File:    char_classes.cpp
+    Created: 20 October 2026 at 10:31 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include "../include/char_classes.h"
+#include "../include/refinable_partition.h"
+
+static size_t segment_of(const std::vector<char32_t>& bounds, char32_t c)
+{
+    return (std::upper_bound(bounds.begin(), bounds.end(), c) - bounds.begin()) - 1;
+}
+
+Char_classes::Char_classes(const Label_table&           labels,
+                           const std::vector<uint32_t>& used_labels)
+{
+    std::vector<uint32_t> used = used_labels;
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+
+    /* Elementary segments: between consecutive boundaries of ranges of labels. */
+    std::vector<char32_t> bounds{0, max_code_point + 1};
+    for(uint32_t l : used){
+        for(const auto& seg : labels.ranges(l)){
+            bounds.push_back(seg.lower_bound);
+            bounds.push_back(seg.upper_bound + 1);
+        }
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    size_t num_of_segments = bounds.size() - 1;
+
+    /* Segments are equivalent, if they belong to the same labels. The partition into
+     * classes of equivalence is obtained by splitting the set of all segments by each
+     * label. Segments of a label are distinct, since its ranges are disjoint. */
+    Refinable_partition   part;
+    std::vector<uint32_t> group(num_of_segments, 0);
+    part.init(group.data(), num_of_segments, 1);
+    for(uint32_t l : used){
+        for(const auto& seg : labels.ranges(l)){
+            size_t last = segment_of(bounds, seg.upper_bound);
+            for(size_t j = segment_of(bounds, seg.lower_bound); j <= last; ++j){
+                part.mark(static_cast<uint32_t>(j));
+            }
+        }
+        part.split();
+    }
+
+    std::vector<uint32_t> seg_class(num_of_segments);
+    std::vector<uint32_t> number(part.number_of_sets(), no_class);
+    for(size_t j = 0; j < num_of_segments; ++j){
+        uint32_t& cls = number[part.set_of(static_cast<uint32_t>(j))];
+        if(cls == no_class){
+            cls = static_cast<uint32_t>(ranges_.size());
+            ranges_.emplace_back();
+        }
+        seg_class[j] = cls;
+        Segment<char32_t> seg;
+        seg.lower_bound = bounds[j];
+        seg.upper_bound = bounds[j + 1] - 1;
+        ranges_[cls].push_back(seg);
+    }
+
+    label_begin_.assign(1, 0);
+    size_t k = 0;
+    for(uint32_t l = 0; l < labels.size(); ++l){
+        if((k < used.size()) && (used[k] == l)){
+            size_t begin = label_classes_.size();
+            for(const auto& seg : labels.ranges(l)){
+                size_t last = segment_of(bounds, seg.upper_bound);
+                for(size_t j = segment_of(bounds, seg.lower_bound); j <= last; ++j){
+                    label_classes_.push_back(seg_class[j]);
+                }
+            }
+            std::sort(label_classes_.begin() + begin, label_classes_.end());
+            label_classes_.erase(std::unique(label_classes_.begin() + begin,
+                                             label_classes_.end()),
+                                 label_classes_.end());
+            k++;
+        }
+        label_begin_.push_back(static_cast<uint32_t>(label_classes_.size()));
+    }
+
+    build_table(bounds, seg_class);
+}
+
+void Char_classes::build_table(const std::vector<char32_t>& bounds,
+                               const std::vector<uint32_t>& seg_class)
+{
+    size_t num_of_hi = (size_t{max_code_point} >> block_bits) + 1;
+    index_.resize(num_of_hi);
+    blocks_.clear();
+
+    std::unordered_map<uint32_t, uint16_t>    uniform;
+    std::map<std::vector<uint32_t>, uint16_t> mixed;
+    std::vector<uint32_t>                     block(block_size);
+    size_t                                    j = 0;
+    for(size_t hi = 0; hi < num_of_hi; ++hi){
+        char32_t base = static_cast<char32_t>(hi << block_bits);
+        while(bounds[j + 1] <= base){
+            j++;
+        }
+        uint16_t idx = static_cast<uint16_t>(blocks_.size() / block_size);
+        if(bounds[j + 1] >= base + block_size){
+            /* The whole block lies in one segment. */
+            auto it = uniform.emplace(seg_class[j], idx).first;
+            if(it->second == idx){
+                blocks_.insert(blocks_.end(), block_size, seg_class[j]);
+            }
+            index_[hi] = it->second;
+            continue;
+        }
+        size_t s = j;
+        for(size_t low = 0; low < block_size; ++low){
+            while(bounds[s + 1] <= base + low){
+                s++;
+            }
+            block[low] = seg_class[s];
+        }
+        auto it = mixed.emplace(block, idx).first;
+        if(it->second == idx){
+            blocks_.insert(blocks_.end(), block.begin(), block.end());
+        }
+        index_[hi] = it->second;
+    }
+}
+
+std::vector<uint32_t> collect_labels(const std::vector<Rule_info>& rules,
+                                     Label_table&                  labels)
+{
+    using ast::Flat_kind;
+    std::vector<uint32_t> result;
+    for(const auto& ri : rules){
+        ast::Flat_ast fa = ast::to_flat(ri.body_);
+        for(uint32_t i = 0; i < fa.size(); ++i){
+            Flat_kind k = fa.kind(i);
+            if((k == Flat_kind::Character) || (k == Flat_kind::Char_class) ||
+               (k == Flat_kind::Char_class_compl))
+            {
+                result.push_back(labels.label_of(k, fa.payloads_[i]));
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
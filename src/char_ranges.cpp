@@ -0,0 +1,94 @@
+/*
+    File:    char_ranges.cpp
+    Created: 19 October 2026 at 20:11 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include "../include/char_ranges.h"
+
+Char_ranges set_to_ranges(const std::set<char32_t>& s)
+{
+    Char_ranges result;
+    for(char32_t c : s){
+        if(!result.empty() && (result.back().upper_bound + 1 == c)){
+            result.back().upper_bound = c;
+        }else{
+            Segment<char32_t> seg;
+            seg.lower_bound = seg.upper_bound = c;
+            result.push_back(seg);
+        }
+    }
+    return result;
+}
+
+Char_ranges complement_ranges(const Char_ranges& r)
+{
+    Char_ranges result;
+    char32_t    next = 0;
+    bool        done = false;
+    for(const auto& seg : r){
+        if(seg.lower_bound > next){
+            Segment<char32_t> gap;
+            gap.lower_bound = next;
+            gap.upper_bound = seg.lower_bound - 1;
+            result.push_back(gap);
+        }
+        if(seg.upper_bound >= max_code_point){
+            done = true;
+            break;
+        }
+        next = seg.upper_bound + 1;
+    }
+    if(!done){
+        Segment<char32_t> tail;
+        tail.lower_bound = next;
+        tail.upper_bound = max_code_point;
+        result.push_back(tail);
+    }
+    return result;
+}
+
+bool ranges_contain(const Char_ranges& r, char32_t c)
+{
+    auto it = std::upper_bound(r.begin(), r.end(), c,
+                               [](char32_t x, const Segment<char32_t>& seg){
+                                   return x < seg.lower_bound;
+                               });
+    return (it != r.begin()) && (c <= (it - 1)->upper_bound);
+}
+
+uint32_t Label_table::label_of(ast::Flat_kind k, uint64_t payload)
+{
+    auto key = std::make_pair(k, payload);
+    auto it  = ids_.find(key);
+    if(it != ids_.end()){
+        return it->second;
+    }
+    Char_ranges r;
+    switch(k){
+        case ast::Flat_kind::Character:
+            {
+                Segment<char32_t> seg;
+                seg.lower_bound = seg.upper_bound = static_cast<char32_t>(payload);
+                r.push_back(seg);
+            }
+            break;
+        case ast::Flat_kind::Char_class:
+            r = set_to_ranges(sets_->get_set(payload));
+            break;
+        case ast::Flat_kind::Char_class_compl:
+            r = complement_ranges(set_to_ranges(sets_->get_set(payload)));
+            break;
+        default:
+            ids_[key] = 0;
+            return 0;
+    }
+    uint32_t label = static_cast<uint32_t>(ranges_.size());
+    ranges_.push_back(std::move(r));
+    ids_[key] = label;
+    return label;
+}
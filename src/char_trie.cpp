@@ -42,12 +42,29 @@ std::u32string Char_trie::get_string(size_t idx)
 
 void Char_trie::print(size_t idx)
 {
-    std::u32string s32 = get_string(idx);
-    std::string    s8  = u32string_to_utf8(s32);
-    printf("%s",s8.c_str());
+    printf("%s",get_utf8_string(idx).c_str());
 }
 
 size_t Char_trie::get_length(size_t idx)
 {
     return node_buffer[idx].path_len;
+}
+
+const std::string& Char_trie::get_utf8_string(size_t idx)
+{
+    if(idx >= utf8_slots_.size()){
+        utf8_slots_.resize(node_buffer.size());
+    }
+    size_t& slot = utf8_slots_[idx];
+    if(!slot){
+        utf8_names_.push_back(u32string_to_utf8(get_string(idx)));
+        slot = utf8_names_.size();
+    }
+    return utf8_names_[slot - 1];
+}
+
+void Char_trie::contents_replaced()
+{
+    utf8_slots_.clear();
+    utf8_names_.clear();
 }
\ No newline at end of file
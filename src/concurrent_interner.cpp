@@ -0,0 +1,128 @@
+/*
+    File:    concurrent_interner.cpp
+    Created: 19 October 2026 at 09:40 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <functional>
+#include "../include/concurrent_interner.h"
+
+/* This function returns the least power of two which is not less than n. */
+static size_t round_up_to_power_of_two(size_t n)
+{
+    size_t result = 1;
+    while(result < n){
+        result <<= 1;
+    }
+    return result;
+}
+
+Concurrent_interner::Concurrent_interner(size_t num_of_shards)
+{
+    size_t n     = round_up_to_power_of_two(std::max<size_t>(num_of_shards, 1));
+    shards_      = std::make_unique<Shard[]>(n);
+    shards_mask_ = n - 1;
+    next_id_     = 1;
+}
+
+Concurrent_interner::Shard& Concurrent_interner::shard_for(const std::u32string& s) const
+{
+    size_t h = std::hash<std::u32string>()(s);
+    /* The lower bits of the hash are used by std::unordered_map inside the shard,
+     * so the shard is selected by the higher bits. */
+    h ^= h >> 29;
+    return shards_[(h >> 7) & shards_mask_];
+}
+
+size_t Concurrent_interner::insert(const std::u32string& s)
+{
+    if(s.empty()){
+        return 0;
+    }
+    Shard&                      shard = shard_for(s);
+    std::lock_guard<std::mutex> lock(shard.mtx_);
+    auto                        it    = shard.ids_.find(s);
+    if(it != shard.ids_.end()){
+        return it->second;
+    }
+    size_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    shard.ids_.emplace(s, id);
+    return id;
+}
+
+std::pair<bool, size_t> Concurrent_interner::find(const std::u32string& s) const
+{
+    std::pair<bool, size_t> result = {true, 0};
+    if(s.empty()){
+        return result;
+    }
+    Shard&                      shard = shard_for(s);
+    std::lock_guard<std::mutex> lock(shard.mtx_);
+    auto                        it    = shard.ids_.find(s);
+    if(it == shard.ids_.end()){
+        result.first = false;
+    }else{
+        result.second = it->second;
+    }
+    return result;
+}
+
+size_t Concurrent_interner::size() const
+{
+    return next_id_.load(std::memory_order_relaxed) - 1;
+}
+
+std::vector<std::u32string> Concurrent_interner::get_strings() const
+{
+    std::vector<std::u32string> result(size() + 1);
+    for(size_t i = 0; i <= shards_mask_; ++i){
+        for(const auto& p : shards_[i].ids_){
+            result[p.second] = p.first;
+        }
+    }
+    return result;
+}
+
+std::vector<size_t> Concurrent_interner::renumber()
+{
+    size_t n = size();
+    std::vector<const std::u32string*> strs(n + 1, nullptr);
+    for(size_t i = 0; i <= shards_mask_; ++i){
+        for(const auto& p : shards_[i].ids_){
+            strs[p.second] = &p.first;
+        }
+    }
+
+    std::vector<size_t> order(n);
+    for(size_t i = 0; i < n; ++i){
+        order[i] = i + 1;
+    }
+    std::sort(order.begin(), order.end(), [&strs](size_t a, size_t b){
+        return *strs[a] < *strs[b];
+    });
+
+    std::vector<size_t> old2new(n + 1, 0);
+    for(size_t i = 0; i < n; ++i){
+        old2new[order[i]] = i + 1;
+    }
+    for(size_t i = 0; i <= shards_mask_; ++i){
+        for(auto& p : shards_[i].ids_){
+            p.second = old2new[p.second];
+        }
+    }
+    return old2new;
+}
+
+std::vector<size_t> Concurrent_interner::export_to_trie(Char_trie& t) const
+{
+    auto                strs = get_strings();
+    std::vector<size_t> result(strs.size(), 0);
+    for(size_t i = 1; i < strs.size(); ++i){
+        result[i] = t.insert(strs[i]);
+    }
+    return result;
+}
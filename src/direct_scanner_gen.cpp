@@ -0,0 +1,428 @@
+/*
+    File:    direct_scanner_gen.cpp
+    Created: 20 October 2026 at 15:51 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include "../include/direct_scanner_gen.h"
+#include "../include/tagged_dfa.h"
+
+enum class Msg_name{
+    Undefined_action
+};
+
+static const char* messages[] = {
+    "Error: the action $%s is not defined.\n"
+};
+
+static constexpr Str_kinds header_additions_bit =
+    1u << static_cast<uint16_t>(Str_kind::Header_additions);
+static constexpr Str_kinds impl_additions_bit   =
+    1u << static_cast<uint16_t>(Str_kind::Impl_additions);
+static constexpr Str_kinds added_members_bit    =
+    1u << static_cast<uint16_t>(Str_kind::Added_members);
+
+/* Targets with at least this number of ASCII ranges are tested by a bitmap: */
+static constexpr size_t min_ranges_for_bitmap = 3;
+/* Ranges of a state are tested one after another, if there are at most this number of
+ * them. Otherwise ASCII ranges are tested by a switch, which becomes a jump table, and
+ * the other ranges by the binary search. */
+static constexpr size_t max_ranges_for_linear = 4;
+static constexpr char32_t ascii_end           = 128;
+
+static std::string char_literal(char32_t c)
+{
+    if((c < 128) && std::isprint(static_cast<int>(c))){
+        std::string result = "U'";
+        if((c == U'\'') || (c == U'\\')){
+            result += '\\';
+        }
+        result += static_cast<char>(c);
+        return result + "'";
+    }
+    char buf[16];
+    snprintf(buf, sizeof(buf), "0x%X", static_cast<unsigned>(c));
+    return buf;
+}
+
+static std::string hex64(uint64_t x)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "0x%016llXULL", static_cast<unsigned long long>(x));
+    return buf;
+}
+
+/* The header guard for the class name: */
+static std::string guard_of(const std::string& class_name)
+{
+    std::string result;
+    for(char c : class_name){
+        result += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return result + "_H";
+}
+
+class Direct_scanner_generator{
+public:
+    Direct_scanner_generator(const Lexer_dfa&        lexer,
+                             const Scope&            scope,
+                             const Errors_and_tries& et) :
+        lexer_(lexer), dfa_(lexer.dfa_), scope_(scope), et_(et) {}
+    Direct_scanner_generator(const Direct_scanner_generator&) = delete;
+    ~Direct_scanner_generator()                               = default;
+
+    Scanner_code generate(const std::string& class_name, const std::string& header_name);
+private:
+    /* A range of characters by which the transition to target_ with the set of
+     * actions actions_ is made: */
+    struct Range{
+        char32_t lo_;
+        char32_t hi_;
+        uint32_t target_;
+        uint32_t actions_;
+    };
+
+    const Lexer_dfa&        lexer_;
+    const Dfa&              dfa_;
+    const Scope&            scope_;
+    const Errors_and_tries& et_;
+    std::string             out_;
+    std::vector<Range>      ranges_;
+    /* Code of actions by indices of actions: */
+    std::map<uint64_t, std::string> action_code_;
+
+    std::string strings_of_kind(Str_kinds kind_bit) const;
+    std::string token_enum();
+    void        collect_ranges(uint32_t s);
+    void        emit_transition(uint32_t target, uint32_t actions, const std::string& ind);
+    void        emit_actions(uint32_t actions, const std::string& ind);
+    void        emit_execute_actions(const std::string& class_name);
+    void        emit_bitmaps(const std::string& ind);
+    void        emit_switch(const std::string& ind);
+    void        emit_tree(size_t l, size_t r, const std::string& ind);
+    void        emit_state(uint32_t s);
+    const std::string& code_of_action(uint64_t action);
+};
+
+std::string Direct_scanner_generator::strings_of_kind(Str_kinds kind_bit) const
+{
+    std::string result;
+    scope_.strsc_.for_each([&](size_t idx, const Str_attributes& attr){
+        if(attr.kind_ & kind_bit){
+            result += et_.strs_trie->get_utf8_string(idx);
+            result += '\n';
+        }
+    });
+    return result;
+}
+
+std::string Direct_scanner_generator::token_enum()
+{
+    std::string result = "    enum Token : int{\n        None = -1";
+    for(size_t t = 0; t < lexer_.tokens_.size(); ++t){
+        const auto& tok = lexer_.tokens_[t];
+        result += ",\n        " + token_name(lexer_, t, et_) + " = " + std::to_string(t);
+        if(tok.kind_ != Token_kind::Rule){
+            result += " /* code " + std::to_string(tok.code_) + " */";
+        }
+    }
+    return result + "\n    };\n";
+}
+
+const std::string& Direct_scanner_generator::code_of_action(uint64_t action)
+{
+    auto it = action_code_.find(action);
+    if(it != action_code_.end()){
+        return it->second;
+    }
+    const auto& name = et_.ids_trie->get_utf8_string(action);
+    const auto* attr = scope_.idsc_.find(action);
+    std::string code;
+    if(attr && (attr->kind_ & (1u << static_cast<uint8_t>(Id_kind::Action_name)))){
+        code = "/* $" + name + " */ " + et_.strs_trie->get_utf8_string(attr->act_string_);
+    }else{
+        printf(messages[static_cast<unsigned>(Msg_name::Undefined_action)], name.c_str());
+        et_.ec->increment_number_of_errors();
+        code = "/* undefined action $" + name + " */";
+    }
+    return action_code_.emplace(action, code).first->second;
+}
+
+void Direct_scanner_generator::collect_ranges(uint32_t s)
+{
+    ranges_.clear();
+    size_t k = dfa_.number_of_symbols();
+    for(uint32_t sym = 0; sym < k; ++sym){
+        uint32_t t = dfa_.next(s, sym);
+        if(t == Dfa::no_state){
+            continue;
+        }
+        uint32_t a = dfa_.has_actions() ? dfa_.trans_actions_[s * k + sym] : 0;
+        for(const auto& seg : dfa_.classes_.ranges(sym)){
+            ranges_.push_back(Range{seg.lower_bound, seg.upper_bound, t, a});
+        }
+    }
+    std::sort(ranges_.begin(), ranges_.end(), [](const Range& x, const Range& y){
+        return x.lo_ < y.lo_;
+    });
+    /* Adjacent ranges with the same transition are merged. */
+    size_t m = 0;
+    for(const auto& rg : ranges_){
+        Range* last = m ? &ranges_[m - 1] : nullptr;
+        if(last && (last->hi_ + 1 == rg.lo_) && (last->target_ == rg.target_) &&
+           (last->actions_ == rg.actions_))
+        {
+            last->hi_ = rg.hi_;
+        }else{
+            ranges_[m++] = rg;
+        }
+    }
+    ranges_.resize(m);
+}
+
+/* The actions of the set with the index actions, tagged with the variable token: */
+void Direct_scanner_generator::emit_actions(uint32_t actions, const std::string& ind)
+{
+    for(uint64_t tag : dfa_.action_sets_[actions]){
+        out_ += ind + "if(token == " + std::to_string(tag_rule(tag)) + "){\n" +
+                ind + "    " + code_of_action(tag_action(tag)) + "\n" + ind + "}\n";
+    }
+}
+
+void Direct_scanner_generator::emit_transition(uint32_t           target,
+                                               uint32_t           actions,
+                                               const std::string& ind)
+{
+    out_ += ind + "++p;\n";
+    if(dfa_.has_actions()){
+        out_ += ind + "trail_.push_back(" + std::to_string(actions) + ");\n";
+    }
+    out_ += ind + "goto state_" + std::to_string(target) + ";\n";
+}
+
+/*
+ * The function execute_actions replays the transitions of the matched token, which
+ * are recorded in trail_ by next_token, and executes the actions tagged with this
+ * token, with the consumed characters as ch.
+ */
+void Direct_scanner_generator::emit_execute_actions(const std::string& class_name)
+{
+    out_ += "\nvoid " + class_name + "::execute_actions(const char32_t* begin, "
+            "const char32_t* end, int token)\n{\n";
+    if(dfa_.start_actions_){
+        emit_actions(dfa_.start_actions_, "    ");
+    }
+    out_ += "    for(size_t k = 0; begin + k != end; ++k){\n"
+            "        char32_t ch = begin[k];\n"
+            "        switch(trail_[k]){\n";
+    for(uint32_t a = 1; a < dfa_.action_sets_.size(); ++a){
+        out_ += "            case " + std::to_string(a) + ":\n";
+        emit_actions(a, "                ");
+        out_ += "                break;\n";
+    }
+    out_ += "            default:\n"
+            "                ;\n"
+            "        }\n"
+            "        (void)ch;\n"
+            "    }\n"
+            "}\n";
+}
+
+void Direct_scanner_generator::emit_bitmaps(const std::string& ind)
+{
+    /* Ranges are grouped by transitions; a group of ASCII ranges large enough is tested
+     * by a bitmap, and its ranges are removed. */
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<size_t>> groups;
+    for(size_t i = 0; i < ranges_.size(); ++i){
+        groups[std::make_pair(ranges_[i].target_, ranges_[i].actions_)].push_back(i);
+    }
+    std::vector<uint8_t> removed(ranges_.size(), 0);
+    for(const auto& g : groups){
+        if(g.second.size() < min_ranges_for_bitmap){
+            continue;
+        }
+        if(ranges_[g.second.back()].hi_ >= ascii_end){
+            continue;
+        }
+        uint64_t bits[2] = {0, 0};
+        for(size_t i : g.second){
+            for(char32_t c = ranges_[i].lo_; c <= ranges_[i].hi_; ++c){
+                bits[c / 64] |= uint64_t{1} << (c % 64);
+            }
+            removed[i] = 1;
+        }
+        out_ += ind + "if((ch < 128) && (((ch < 64) ? (" + hex64(bits[0]) + " >> ch) : (" +
+                hex64(bits[1]) + " >> (ch - 64))) & 1)){\n";
+        emit_transition(g.first.first, g.first.second, ind + "    ");
+        out_ += ind + "}\n";
+    }
+    size_t m = 0;
+    for(size_t i = 0; i < ranges_.size(); ++i){
+        if(!removed[i]){
+            ranges_[m++] = ranges_[i];
+        }
+    }
+    ranges_.resize(m);
+}
+
+void Direct_scanner_generator::emit_switch(const std::string& ind)
+{
+    if(ranges_.size() <= max_ranges_for_linear){
+        return;
+    }
+    std::vector<Range> others;
+    std::map<std::pair<uint32_t, uint32_t>, std::string> labels;
+    for(Range rg : ranges_){
+        if(rg.hi_ >= ascii_end){
+            Range high = rg;
+            high.lo_   = std::max(rg.lo_, ascii_end);
+            others.push_back(high);
+            if(rg.lo_ >= ascii_end){
+                continue;
+            }
+            rg.hi_ = ascii_end - 1;
+        }
+        std::string& cases = labels[std::make_pair(rg.target_, rg.actions_)];
+        for(char32_t c = rg.lo_; c <= rg.hi_; ++c){
+            cases += ind + "        case " + char_literal(c) + ":\n";
+        }
+    }
+    if(labels.empty()){
+        return;
+    }
+    out_ += ind + "if(ch < " + std::to_string(ascii_end) + "){\n";
+    out_ += ind + "    switch(ch){\n";
+    for(const auto& l : labels){
+        out_ += l.second;
+        emit_transition(l.first.first, l.first.second, ind + "            ");
+    }
+    out_ += ind + "        default:\n" + ind + "            goto done;\n";
+    out_ += ind + "    }\n" + ind + "}\n";
+    ranges_ = std::move(others);
+}
+
+void Direct_scanner_generator::emit_tree(size_t l, size_t r, const std::string& ind)
+{
+    if(r - l <= max_ranges_for_linear){
+        for(size_t i = l; i < r; ++i){
+            const Range& rg = ranges_[i];
+            if(rg.lo_ == rg.hi_){
+                out_ += ind + "if(ch == " + char_literal(rg.lo_) + "){\n";
+            }else if(!rg.lo_){
+                /* ch >= 0 is always true, and is warned about by -Wtype-limits. */
+                out_ += ind + "if(ch <= " + char_literal(rg.hi_) + "){\n";
+            }else{
+                out_ += ind + "if((ch >= " + char_literal(rg.lo_) + ") && (ch <= " +
+                        char_literal(rg.hi_) + ")){\n";
+            }
+            emit_transition(rg.target_, rg.actions_, ind + "    ");
+            out_ += ind + "}\n";
+        }
+        out_ += ind + "goto done;\n";
+        return;
+    }
+    size_t m = l + (r - l) / 2;
+    out_ += ind + "if(ch < " + char_literal(ranges_[m].lo_) + "){\n";
+    emit_tree(l, m, ind + "    ");
+    out_ += ind + "}else{\n";
+    emit_tree(m, r, ind + "    ");
+    out_ += ind + "}\n";
+}
+
+void Direct_scanner_generator::emit_state(uint32_t s)
+{
+    const std::string ind = "    ";
+    out_ += "state_" + std::to_string(s) + ":\n";
+    if(dfa_.accept_[s] != Dfa::no_state){
+        out_ += ind + "last_token = " + std::to_string(dfa_.accept_[s]) + ";\n";
+        out_ += ind + "last_end   = p;\n";
+    }
+    collect_ranges(s);
+    if(ranges_.empty()){
+        out_ += ind + "goto done;\n";
+        return;
+    }
+    out_ += ind + "if(p == end){\n" + ind + "    goto done;\n" + ind + "}\n";
+    out_ += ind + "ch = *p;\n";
+    emit_bitmaps(ind);
+    emit_switch(ind);
+    emit_tree(0, ranges_.size(), ind);
+}
+
+Scanner_code Direct_scanner_generator::generate(const std::string& class_name,
+                                                const std::string& header_name)
+{
+    Scanner_code result;
+    std::string  guard = guard_of(class_name);
+    bool         actions = dfa_.has_actions();
+    result.header_ = "#ifndef " + guard + "\n#define " + guard + "\n"
+                     "#include <cstddef>\n#include <cstdint>\n#include <string>\n"
+                     "#include <vector>\n" +
+                     strings_of_kind(header_additions_bit) +
+                     "class " + class_name + "{\npublic:\n" + token_enum() +
+                     "\n    /* Returns the longest token at p, or None, and moves p to the "
+                     "end of the token. */\n"
+                     "    int next_token(const char32_t*& p, const char32_t* end);\n" +
+                     strings_of_kind(added_members_bit);
+    if(actions){
+        result.header_ += "private:\n"
+                          "    /* Sets of actions of the transitions made by next_token: */\n"
+                          "    std::vector<uint32_t> trail_;\n\n"
+                          "    void execute_actions(const char32_t* begin, "
+                          "const char32_t* end, int token);\n";
+    }
+    result.header_ += "};\n#endif\n";
+
+    out_  = "#include \"" + header_name + "\"\n" + strings_of_kind(impl_additions_bit);
+    out_ += "\nint " + class_name + "::next_token(const char32_t*& p, "
+            "const char32_t* end)\n{\n"
+            "    const char32_t* begin      = p;\n"
+            "    const char32_t* last_end   = p;\n"
+            "    int             last_token = None;\n"
+            "    char32_t        ch         = 0;\n";
+    if(actions){
+        out_ += "    trail_.clear();\n";
+    }
+    if(dfa_.start_ != Dfa::no_state){
+        out_ += "    goto state_" + std::to_string(dfa_.start_) + ";\n";
+        for(uint32_t s = 0; s < dfa_.number_of_states(); ++s){
+            emit_state(s);
+        }
+        /* Without states nothing jumps to the label, and -Wunused-label warns. */
+        out_ += "done:\n";
+    }
+    out_ += "    (void)ch;\n"
+            "    (void)begin;\n"
+            "    (void)end;\n"
+            "    p = last_end;\n";
+    if(actions){
+        out_ += "    if(last_token != None){\n"
+                "        execute_actions(begin, last_end, last_token);\n"
+                "    }\n";
+    }
+    out_ += "    return last_token;\n"
+            "}\n";
+    if(actions){
+        emit_execute_actions(class_name);
+    }
+    result.impl_ = std::move(out_);
+    return result;
+}
+
+Scanner_code generate_direct_scanner(const Lexer_dfa&        lexer,
+                                     const Scope&            scope,
+                                     const Errors_and_tries& et,
+                                     const std::string&      class_name,
+                                     const std::string&      header_name)
+{
+    Direct_scanner_generator gen(lexer, scope, et);
+    return gen.generate(class_name, header_name);
+}
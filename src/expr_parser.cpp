@@ -8,10 +8,10 @@
 */
 
 #include <cstdint>
+#include <utility>
 #include "../include/expr_parser.h"
 #include "../include/expr_lexem_info.h"
 #include "../include/belongs.h"
-#include "../include/idx_to_string.h"
 
 /* Grammar rules for regexps:
  *
@@ -147,20 +147,23 @@ private:
     Errors_and_tries               et_;
     std::shared_ptr<Scope>         scope_;
 
-    std::shared_ptr<ast::Ast_elem> proc_S();
-    std::shared_ptr<ast::Ast_elem> proc_T();
-    std::shared_ptr<ast::Ast_elem> proc_E();
-    std::shared_ptr<ast::Ast_elem> proc_F();
-    std::shared_ptr<ast::Ast_elem> proc_G();
-    std::shared_ptr<ast::Ast_elem> proc_H();
+    /* The arena for nodes of the currently parsed regexp. */
+    ast::Ast_arena_ptr             arena_;
+
+    ast::Ast_elem* proc_S();
+    ast::Ast_elem* proc_T();
+    ast::Ast_elem* proc_E();
+    ast::Ast_elem* proc_F();
+    ast::Ast_elem* proc_G();
+    ast::Ast_elem* proc_H();
 
 //     Expr_lexem_info li_;
 //     Terminal        t_;
 
-    bool proc_H_state_Start(std::shared_ptr<ast::Ast_elem>& e,
-                            H_State&                        state,
-                            Expr_lexem_info                 li,
-                            Terminal                        t);
+    bool proc_H_state_Start(ast::Ast_elem*& e,
+                            H_State&        state,
+                            Expr_lexem_info li,
+                            Terminal        t);
 };
 
 Expr_parser::~Expr_parser() = default;
@@ -179,7 +182,10 @@ ast::Regexp_ast Expr_parser::compile()
 
 ast::Regexp_ast Expr_parser::Impl::compile()
 {
-    return ast::Regexp_ast{proc_S()};
+    std::pmr::polymorphic_allocator<ast::Ast_arena> alloc(et_.memory_resource);
+    arena_    = std::allocate_shared<ast::Ast_arena>(alloc, et_.memory_resource);
+    auto root = proc_S();
+    return ast::Regexp_ast{std::move(arena_), root};
 }
 
 static const Terminal lexem2terminal_map[] = {
@@ -232,9 +238,9 @@ static const char* expected_rp                     =
     "Error at line %zu: expected closing round bracket.\n";
 
 
-std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_S()
+ast::Ast_elem* Expr_parser::Impl::proc_S()
 {
-    std::shared_ptr<ast::Ast_elem> result;
+    ast::Ast_elem* result = nullptr;
     enum class State{
         Start, Open_fig_bracket, T, Close_fig_bracket
     };
@@ -280,10 +286,11 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_S()
     return result;
 }
 
-using Or_args = std::list<std::shared_ptr<ast::Ast_elem>>;
+using Or_args = ast::Children;
 
-static std::shared_ptr<ast::Ast_elem> build_or_node(const Or_args& children,
-                                                    size_t         num_of_children)
+static ast::Ast_elem* build_or_node(Or_args&&       children,
+                                    size_t          num_of_children,
+                                    ast::Ast_arena& arena)
 {
     switch(num_of_children){
         case 0:
@@ -291,22 +298,22 @@ static std::shared_ptr<ast::Ast_elem> build_or_node(const Or_args& children,
         case 1:
             return children.front();
         default:
-            return std::make_shared<ast::Binary_op>(ast::Binary_op_kind::Or,
-                                                    children);
+            return arena.create<ast::Binary_op>(ast::Binary_op_kind::Or,
+                                                std::move(children));
     }
 }
 
-std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_T()
+ast::Ast_elem* Expr_parser::Impl::proc_T()
 {
-    std::shared_ptr<ast::Ast_elem> node;
+    ast::Ast_elem* node = nullptr;
 
     enum class State{
         Start, E
     };
 
-    State                                     state           = State::Start;
-    std::list<std::shared_ptr<ast::Ast_elem>> children;
-    size_t                                    num_of_children = 0;
+    State   state           = State::Start;
+    Or_args children(arena_->resource());
+    size_t  num_of_children = 0;
     for(;;){
         Expr_lexem_info li = esc_->current_lexem();
         Terminal        t  = lexem2terminal(li);
@@ -328,7 +335,7 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_T()
                     state = State::Start;
                 }else{
                     esc_->back();
-                    return build_or_node(children, num_of_children);
+                    return build_or_node(std::move(children), num_of_children, *arena_);
                 }
                 break;
         }
@@ -336,10 +343,11 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_T()
     return node;
 }
 
-using Concat_args = std::list<std::shared_ptr<ast::Ast_elem>>;
+using Concat_args = ast::Children;
 
-static std::shared_ptr<ast::Ast_elem> build_concat_node(const Concat_args& children,
-                                                        size_t             num_of_children)
+static ast::Ast_elem* build_concat_node(Concat_args&&   children,
+                                        size_t          num_of_children,
+                                        ast::Ast_arena& arena)
 {
     switch(num_of_children){
         case 0:
@@ -347,22 +355,22 @@ static std::shared_ptr<ast::Ast_elem> build_concat_node(const Concat_args& child
         case 1:
             return children.front();
         default:
-            return std::make_shared<ast::Binary_op>(ast::Binary_op_kind::Concat,
-                                                    children);
+            return arena.create<ast::Binary_op>(ast::Binary_op_kind::Concat,
+                                                std::move(children));
     }
 }
 
-std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_E()
+ast::Ast_elem* Expr_parser::Impl::proc_E()
 {
-    std::shared_ptr<ast::Ast_elem> node;
+    ast::Ast_elem* node = nullptr;
 
     enum class State{
         Start, F
     };
 
-    State                                     state           = State::Start;
-    std::list<std::shared_ptr<ast::Ast_elem>> children;
-    size_t                                    num_of_children = 0;
+    State       state           = State::Start;
+    Concat_args children(arena_->resource());
+    size_t      num_of_children = 0;
     for(;;){
         Expr_lexem_info li = esc_->current_lexem();
         Terminal        t  = lexem2terminal(li);
@@ -383,12 +391,14 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_E()
                 if((t == Terminal::Term_d) || (t == Terminal::Term_LP)){
                     auto p = proc_F();
                     if(!p){
-                        return build_concat_node(children, num_of_children);
+                        return build_concat_node(std::move(children),
+                                                 num_of_children,
+                                                 *arena_);
                     }
                     children.push_back(p);
                     num_of_children++;
                 }else{
-                    return build_concat_node(children, num_of_children);
+                    return build_concat_node(std::move(children), num_of_children, *arena_);
                 }
                 break;
         }
@@ -402,9 +412,9 @@ static inline ast::Unary_op_kind lexem2unary_kind(const Expr_lexem_info& li)
     return static_cast<ast::Unary_op_kind>(static_cast<uint16_t>(li.code) - shift);
 }
 
-std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_F()
+ast::Ast_elem* Expr_parser::Impl::proc_F()
 {
-    std::shared_ptr<ast::Ast_elem> node;
+    ast::Ast_elem* node = nullptr;
 
     enum class State{
         Start, G, Unary
@@ -430,8 +440,7 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_F()
                 }
                 state = State::Unary;
                 {
-                    auto p = std::make_shared<ast::Unary_op>(lexem2unary_kind(li), node);
-                    node   = p;
+                    node = arena_->create<ast::Unary_op>(lexem2unary_kind(li), node);
                 }
                 break;
             case State::Unary:
@@ -447,9 +456,9 @@ static inline uint64_t check_id_attribute(Id_kind ikind, Id_attributes iattr)
     return belongs(static_cast<uint8_t>(ikind), iattr.kind_);
 }
 
-std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_G()
+ast::Ast_elem* Expr_parser::Impl::proc_G()
 {
-    std::shared_ptr<ast::Ast_elem> node;
+    ast::Ast_elem* node = nullptr;
 
     enum class State{
         Start, H, Act
@@ -471,20 +480,19 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_G()
             case State::H:
                 if(t == Terminal::Term_a){
                     state           = State::Act;
-                    auto&  id_scope = scope_->idsc_;
                     size_t act_idx  = li.action_name_index;
-                    auto   it        = id_scope.find(act_idx);
-                    if(it == id_scope.end()){
-                        auto str = idx_to_string(et_.ids_trie, act_idx);
+                    auto   attr     = scope_->idsc_.find(act_idx);
+                    if(!attr){
+                        const auto& str = et_.ids_trie->get_utf8_string(act_idx);
                         printf(undefined_action,
                                esc_->lexem_begin_line_number(),
                                str.c_str());
                         et_.ec->increment_number_of_errors();
                         return nullptr;
                     }
-                    if(!check_id_attribute(Id_kind::Action_name, it->second))
+                    if(!check_id_attribute(Id_kind::Action_name, *attr))
                     {
-                        auto str = idx_to_string(et_.ids_trie, act_idx);
+                        const auto& str = et_.ids_trie->get_utf8_string(act_idx);
                         printf(not_action_name,
                                esc_->lexem_begin_line_number(),
                                str.c_str());
@@ -505,21 +513,21 @@ std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_G()
     return node;
 }
 
-static std::shared_ptr<ast::Leaf> lexem2leaf(const Expr_lexem_info& li)
+static ast::Leaf* lexem2leaf(const Expr_lexem_info& li, ast::Ast_arena& arena)
 {
-    std::shared_ptr<ast::Leaf> result;
+    ast::Leaf* result = nullptr;
     switch(li.code){
         case Expr_lexem_code::Regexp_name:
-            result = std::make_shared<ast::Regexp_name_leaf>(li.regexp_name_index);
+            result = arena.create<ast::Regexp_name_leaf>(li.regexp_name_index);
             break;
         case Expr_lexem_code::Character:
-            result = std::make_shared<ast::Character_leaf>(li.c);
+            result = arena.create<ast::Character_leaf>(li.c);
             break;
         case Expr_lexem_code::Class_complement:
-            result = std::make_shared<ast::Char_class_compl_leaf>(li.set_of_char_index);
+            result = arena.create<ast::Char_class_compl_leaf>(li.set_of_char_index);
             break;
         case Expr_lexem_code::Character_class:
-            result = std::make_shared<ast::Char_class_leaf>(li.set_of_char_index);
+            result = arena.create<ast::Char_class_leaf>(li.set_of_char_index);
             break;
         default:
             ;
@@ -527,15 +535,15 @@ static std::shared_ptr<ast::Leaf> lexem2leaf(const Expr_lexem_info& li)
     return result;
 }
 
-bool Expr_parser::Impl::proc_H_state_Start(std::shared_ptr<ast::Ast_elem>& node,
-                                           H_State&                        state,
-                                           Expr_lexem_info                 li,
-                                           Terminal                        t)
+bool Expr_parser::Impl::proc_H_state_Start(ast::Ast_elem*& node,
+                                           H_State&        state,
+                                           Expr_lexem_info li,
+                                           Terminal        t)
 {
     bool there_are_errors = true;
     switch(t){
         case Terminal::Term_d:
-            node              = lexem2leaf(li);
+            node              = lexem2leaf(li, *arena_);
             state             = H_State::D;
             there_are_errors  = false;
             break;
@@ -576,9 +584,9 @@ bool Expr_parser::Impl::proc_H_state_Start(std::shared_ptr<ast::Ast_elem>& node,
     return there_are_errors;
 }
 
-std::shared_ptr<ast::Ast_elem> Expr_parser::Impl::proc_H()
+ast::Ast_elem* Expr_parser::Impl::proc_H()
 {
-    std::shared_ptr<ast::Ast_elem> node;
+    ast::Ast_elem* node = nullptr;
 
     H_State state = H_State::Start;
     for(;;){
@@ -0,0 +1,217 @@
+/*
+    File:    factor_literals.cpp
+    Created: 19 October 2026 at 17:08 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../include/factor_literals.h"
+#include "../include/flat_ast.h"
+#include "../include/trie.h"
+
+namespace ast{
+    /* The prefix tree of literals. The function post_action marks ends of literals. */
+    class Literal_trie : public Trie<char32_t>{
+    public:
+        Literal_trie()                    = default;
+        Literal_trie(const Literal_trie&) = default;
+        virtual ~Literal_trie()           = default;
+
+        bool     is_end(size_t idx)      const {return ends_[idx];};
+        size_t   first_child(size_t idx) const {return node_buffer[idx].first_child;};
+        size_t   next(size_t idx)        const {return node_buffer[idx].next;};
+        char32_t label(size_t idx)       const {return node_buffer[idx].c;};
+    private:
+        std::vector<bool> ends_;
+
+        void post_action(std::u32string_view s, size_t n) override
+        {
+            ends_.resize(node_buffer.size());
+            ends_[n] = true;
+        }
+    };
+
+    /* If the node elem is a literal, then this function writes it into s. */
+    static bool get_literal(Ast_elem* elem, std::u32string& s)
+    {
+        if(elem->action_idx_){
+            return false;
+        }
+        auto d = describe(elem);
+        if(d.kind_ == Flat_kind::Character){
+            s = std::u32string(1, static_cast<char32_t>(d.payload_));
+            return true;
+        }
+        if(d.kind_ != Flat_kind::Concat){
+            return false;
+        }
+        s.clear();
+        for(size_t i = 0; i < d.num_of_children_; ++i){
+            Ast_elem* c  = d.children_[i];
+            auto      dc = describe(c);
+            if((dc.kind_ != Flat_kind::Character) || c->action_idx_){
+                return false;
+            }
+            s += static_cast<char32_t>(dc.payload_);
+        }
+        return true;
+    }
+
+    class Literal_factorizer : public Visitor{
+    public:
+        Literal_factorizer(Ast_arena& arena) : arena_(arena) {}
+        Literal_factorizer(const Literal_factorizer&) = default;
+        virtual ~Literal_factorizer()                 = default;
+
+        Ast_elem* factor(Ast_elem* elem)
+        {
+            elem->accept(*this);
+            return result_;
+        }
+
+        void visit(Binary_op&             ref) override;
+        void visit(Unary_op&              ref) override;
+        void visit(Regexp_name_leaf&      ref) override;
+        void visit(Character_leaf&        ref) override;
+        void visit(Char_class_leaf&       ref) override;
+        void visit(Char_class_compl_leaf& ref) override;
+    private:
+        Ast_arena& arena_;
+        Ast_elem*  result_ = nullptr;
+
+        Ast_elem* build_suffixes(const Literal_trie& t, size_t v);
+    };
+
+    void Literal_factorizer::visit(Regexp_name_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Literal_factorizer::visit(Character_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Literal_factorizer::visit(Char_class_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Literal_factorizer::visit(Char_class_compl_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Literal_factorizer::visit(Unary_op& ref)
+    {
+        Ast_elem* child = factor(ref.child_);
+        if(child == ref.child_){
+            result_              = &ref;
+        }else{
+            result_              = arena_.create<Unary_op>(ref.kind_, child);
+            result_->action_idx_ = ref.action_idx_;
+        }
+    }
+
+    /*
+     * This function builds the regexp for the set of non-empty suffixes of literals
+     * that pass through the node v of the prefix tree. Each edge of the prefix tree is
+     * represented by exactly one Character_leaf, so the result has the size proportional
+     * to the size of the prefix tree.
+     */
+    Ast_elem* Literal_factorizer::build_suffixes(const Literal_trie& t, size_t v)
+    {
+        Children alternatives(arena_.resource());
+        for(size_t u = t.first_child(v); u; u = t.next(u)){
+            Ast_elem* head = arena_.create<Character_leaf>(t.label(u));
+            if(!t.first_child(u)){
+                alternatives.push_back(head);
+                continue;
+            }
+            Ast_elem* tail = build_suffixes(t, u);
+            Children  concat_args(arena_.resource());
+            concat_args.push_back(head);
+            if(t.is_end(u)){
+                auto opt = arena_.create<Unary_op>(Unary_op_kind::Optional, tail);
+                concat_args.push_back(opt);
+            }else{
+                auto d = describe(tail);
+                if(d.kind_ == Flat_kind::Concat){
+                    for(size_t i = 0; i < d.num_of_children_; ++i){
+                        concat_args.push_back(d.children_[i]);
+                    }
+                }else{
+                    concat_args.push_back(tail);
+                }
+            }
+            alternatives.push_back(arena_.create<Binary_op>(Binary_op_kind::Concat,
+                                                            std::move(concat_args)));
+        }
+        if(alternatives.size() == 1){
+            return alternatives[0];
+        }
+        return arena_.create<Binary_op>(Binary_op_kind::Or, std::move(alternatives));
+    }
+
+    void Literal_factorizer::visit(Binary_op& ref)
+    {
+        bool     modified = false;
+        Children children(arena_.resource());
+        for(Ast_elem* c : ref.children_){
+            Ast_elem* f = factor(c);
+            modified    = modified || (f != c);
+            children.push_back(f);
+        }
+
+        if(ref.kind_ == Binary_op_kind::Or){
+            Literal_trie   t;
+            std::u32string s;
+            size_t         num_of_literals = 0;
+            size_t         first_literal   = children.size();
+            for(size_t i = 0; i < children.size(); ++i){
+                if(get_literal(children[i], s)){
+                    t.insert(s);
+                    num_of_literals++;
+                    first_literal = std::min(first_literal, i);
+                }
+            }
+            if(num_of_literals >= 2){
+                Children rest(arena_.resource());
+                for(size_t i = 0; i < children.size(); ++i){
+                    if(i == first_literal){
+                        rest.push_back(build_suffixes(t, 0));
+                    }else if(!get_literal(children[i], s)){
+                        rest.push_back(children[i]);
+                    }
+                }
+                children = std::move(rest);
+                modified = true;
+            }
+        }
+
+        if(!modified){
+            result_              = &ref;
+        }else if((children.size() == 1) && !ref.action_idx_){
+            result_              = children[0];
+        }else{
+            result_              = arena_.create<Binary_op>(ref.kind_,
+                                                            std::move(children));
+            result_->action_idx_ = ref.action_idx_;
+        }
+    }
+
+    Regexp_ast factor_literals(const Regexp_ast& tree)
+    {
+        Ast_elem* root = tree.get_root();
+        if(!root){
+            return tree;
+        }
+        Literal_factorizer factorizer(*tree.get_arena());
+        return Regexp_ast(tree.get_arena(), factorizer.factor(root));
+    }
+};
@@ -0,0 +1,273 @@
+/*
+    File:    flat_ast.cpp
+    Created: 19 October 2026 at 14:27 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <memory>
+#include "../include/flat_ast.h"
+
+namespace ast{
+    uint32_t Flat_ast::add_node(Flat_kind       k,
+                                const uint32_t* children,
+                                size_t          num_of_children,
+                                uint64_t        payload,
+                                uint64_t        action)
+    {
+        uint32_t idx = static_cast<uint32_t>(kinds_.size());
+        kinds_.push_back(static_cast<uint8_t>(k));
+        first_child_.push_back(static_cast<uint32_t>(children_.size()));
+        num_of_children_.push_back(static_cast<uint32_t>(num_of_children));
+        payloads_.push_back(payload);
+        actions_.push_back(action);
+        children_.insert(children_.end(), children, children + num_of_children);
+        return idx;
+    }
+
+    void Flat_ast::clear()
+    {
+        kinds_.clear();
+        first_child_.clear();
+        num_of_children_.clear();
+        payloads_.clear();
+        actions_.clear();
+        children_.clear();
+    }
+
+    class Describer : public Visitor{
+    public:
+        Describer()                 = default;
+        Describer(const Describer&) = default;
+        virtual ~Describer()        = default;
+
+        Node_descr describe(Ast_elem* elem)
+        {
+            d_ = Node_descr();
+            elem->accept(*this);
+            return d_;
+        }
+
+        void visit(Binary_op& ref) override
+        {
+            d_.kind_            = (ref.kind_ == Binary_op_kind::Or) ? Flat_kind::Or :
+                                                                      Flat_kind::Concat;
+            d_.children_        = ref.children_.data();
+            d_.num_of_children_ = ref.children_.size();
+        }
+
+        void visit(Unary_op& ref) override
+        {
+            switch(ref.kind_){
+                case Unary_op_kind::Kleene:
+                    d_.kind_ = Flat_kind::Kleene;
+                    break;
+                case Unary_op_kind::Positive:
+                    d_.kind_ = Flat_kind::Positive;
+                    break;
+                case Unary_op_kind::Optional:
+                    d_.kind_ = Flat_kind::Optional;
+                    break;
+            }
+            d_.children_        = &ref.child_;
+            d_.num_of_children_ = 1;
+        }
+
+        void visit(Regexp_name_leaf& ref) override
+        {
+            d_.kind_    = Flat_kind::Regexp_name;
+            d_.payload_ = ref.regexp_name_index_;
+        }
+
+        void visit(Character_leaf& ref) override
+        {
+            d_.kind_    = Flat_kind::Character;
+            d_.payload_ = ref.c_;
+        }
+
+        void visit(Char_class_leaf& ref) override
+        {
+            d_.kind_    = Flat_kind::Char_class;
+            d_.payload_ = ref.set_of_char_index_;
+        }
+
+        void visit(Char_class_compl_leaf& ref) override
+        {
+            d_.kind_    = Flat_kind::Char_class_compl;
+            d_.payload_ = ref.set_of_char_index_;
+        }
+    private:
+        Node_descr d_;
+    };
+
+    Node_descr describe(Ast_elem* elem)
+    {
+        Describer describer;
+        return describer.describe(elem);
+    }
+
+    /*
+     * The tree is traversed with an explicit stack, so that the conversion of deeply
+     * nested regexps does not overflow the call stack. An element of the stack is a node
+     * together with the number of its children that are already converted; indices of
+     * converted nodes are accumulated in the stack ids.
+     */
+    struct Frame{
+        Ast_elem*  elem_;
+        Node_descr descr_;
+        size_t     next_child_;
+    };
+
+    Flat_ast to_flat(const Regexp_ast& tree)
+    {
+        Flat_ast  result;
+        Ast_elem* root = tree.get_root();
+        if(!root){
+            return result;
+        }
+        Describer             describer;
+        std::vector<Frame>    stack;
+        std::vector<uint32_t> ids;
+        stack.push_back(Frame{root, describer.describe(root), 0});
+        while(!stack.empty()){
+            Frame& top = stack.back();
+            if(top.next_child_ < top.descr_.num_of_children_){
+                Ast_elem* child = top.descr_.children_[top.next_child_++];
+                stack.push_back(Frame{child, describer.describe(child), 0});
+                continue;
+            }
+            size_t   n   = top.descr_.num_of_children_;
+            uint32_t idx = result.add_node(top.descr_.kind_,
+                                           ids.data() + ids.size() - n,
+                                           n,
+                                           top.descr_.payload_,
+                                           top.elem_->action_idx_);
+            ids.resize(ids.size() - n);
+            ids.push_back(idx);
+            stack.pop_back();
+        }
+        return result;
+    }
+
+    static Ast_elem* create_node(const Flat_ast&               fa,
+                                 uint32_t                      i,
+                                 const std::vector<Ast_elem*>& nodes,
+                                 Ast_arena&                    arena)
+    {
+        const uint32_t* first = fa.children_begin(i);
+        uint64_t        p     = fa.payloads_[i];
+        switch(fa.kind(i)){
+            case Flat_kind::Or: case Flat_kind::Concat:
+                {
+                    Children children(arena.resource());
+                    for(const uint32_t* c = first; c != fa.children_end(i); ++c){
+                        children.push_back(nodes[*c]);
+                    }
+                    auto k = (fa.kind(i) == Flat_kind::Or) ? Binary_op_kind::Or :
+                                                             Binary_op_kind::Concat;
+                    return arena.create<Binary_op>(k, std::move(children));
+                }
+            case Flat_kind::Kleene:
+                return arena.create<Unary_op>(Unary_op_kind::Kleene, nodes[*first]);
+            case Flat_kind::Positive:
+                return arena.create<Unary_op>(Unary_op_kind::Positive, nodes[*first]);
+            case Flat_kind::Optional:
+                return arena.create<Unary_op>(Unary_op_kind::Optional, nodes[*first]);
+            case Flat_kind::Regexp_name:
+                return arena.create<Regexp_name_leaf>(static_cast<size_t>(p));
+            case Flat_kind::Character:
+                return arena.create<Character_leaf>(static_cast<char32_t>(p));
+            case Flat_kind::Char_class:
+                return arena.create<Char_class_leaf>(static_cast<size_t>(p));
+            case Flat_kind::Char_class_compl:
+                return arena.create<Char_class_compl_leaf>(static_cast<size_t>(p));
+        }
+        return nullptr;
+    }
+
+    Regexp_ast from_flat(const Flat_ast& fa, std::pmr::memory_resource* upstream)
+    {
+        if(fa.empty()){
+            return Regexp_ast();
+        }
+        std::pmr::polymorphic_allocator<Ast_arena> alloc(upstream);
+        auto arena = std::allocate_shared<Ast_arena>(alloc, upstream);
+
+        std::vector<Ast_elem*> nodes(fa.size());
+        for(uint32_t i = 0; i < fa.size(); ++i){
+            nodes[i]              = create_node(fa, i, nodes, *arena);
+            nodes[i]->action_idx_ = fa.actions_[i];
+        }
+        return Regexp_ast(arena, nodes[fa.root()]);
+    }
+
+    Regexp_ast from_flat(const Flat_ast&            fa,
+                         uint32_t                   root,
+                         std::pmr::memory_resource* upstream)
+    {
+        if(root == Flat_ast::no_node){
+            return Regexp_ast();
+        }
+        /* Since children precede their parents, the reachable nodes are marked by one
+         * pass from the root down to the node 0. */
+        std::vector<uint8_t> reachable(root + 1);
+        reachable[root] = 1;
+        for(uint32_t i = root + 1; i-- > 0;){
+            if(!reachable[i]){
+                continue;
+            }
+            for(const uint32_t* c = fa.children_begin(i); c != fa.children_end(i); ++c){
+                reachable[*c] = 1;
+            }
+        }
+
+        std::pmr::polymorphic_allocator<Ast_arena> alloc(upstream);
+        auto arena = std::allocate_shared<Ast_arena>(alloc, upstream);
+
+        std::vector<Ast_elem*> nodes(root + 1);
+        for(uint32_t i = 0; i <= root; ++i){
+            if(reachable[i]){
+                nodes[i]              = create_node(fa, i, nodes, *arena);
+                nodes[i]->action_idx_ = fa.actions_[i];
+            }
+        }
+        return Regexp_ast(arena, nodes[root]);
+    }
+
+    std::vector<uint8_t> nullable(const Flat_ast& fa)
+    {
+        std::vector<uint8_t> result(fa.size());
+        for(uint32_t i = 0; i < fa.size(); ++i){
+            const uint32_t* first = fa.children_begin(i);
+            const uint32_t* last  = fa.children_end(i);
+            uint8_t         r     = 0;
+            switch(fa.kind(i)){
+                case Flat_kind::Or:
+                    for(const uint32_t* c = first; c != last; ++c){
+                        r |= result[*c];
+                    }
+                    break;
+                case Flat_kind::Concat:
+                    r = 1;
+                    for(const uint32_t* c = first; c != last; ++c){
+                        r &= result[*c];
+                    }
+                    break;
+                case Flat_kind::Kleene: case Flat_kind::Optional:
+                    r = 1;
+                    break;
+                case Flat_kind::Positive:
+                    r = result[*first];
+                    break;
+                case Flat_kind::Regexp_name: case Flat_kind::Character:
+                case Flat_kind::Char_class:  case Flat_kind::Char_class_compl:
+                    r = 0;
+                    break;
+            }
+            result[i] = r;
+        }
+        return result;
+    }
+};
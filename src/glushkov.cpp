@@ -0,0 +1,201 @@
+/*
+    File:    glushkov.cpp
+    Created: 19 October 2026 at 20:52 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include "../include/glushkov.h"
+
+using ast::Flat_ast;
+using ast::Flat_kind;
+
+static bool is_leaf(Flat_kind k)
+{
+    return static_cast<unsigned>(k) >= static_cast<unsigned>(Flat_kind::Regexp_name);
+}
+
+Position_automaton::Position_automaton(const Flat_ast& fa, Label_table& labels)
+{
+    build(fa, labels);
+}
+
+Position_automaton::Position_automaton(const ast::Regexp_ast& tree, Label_table& labels)
+{
+    build(ast::to_flat(tree), labels);
+}
+
+void Position_automaton::build(const Flat_ast& fa, Label_table& labels)
+{
+    root_ = fa.root();
+    if(root_ == Flat_ast::no_node){
+        root_nullable_ = true;
+        follow_begin_.assign(1, 0);
+        return;
+    }
+    number_positions(fa, labels);
+    calc_sets(fa);
+    calc_follow(fa);
+    root_nullable_ = nullable_[root_];
+}
+
+void Position_automaton::number_positions(const Flat_ast& fa, Label_table& labels)
+{
+    size_t   n    = fa.size();
+    uint32_t next = 0;
+    first_pos_.resize(n);
+    end_pos_.resize(n);
+    offsets_.resize(n);
+    for(uint32_t i = 0; i < n; ++i){
+        Flat_kind k = fa.kind(i);
+        if(is_leaf(k)){
+            first_pos_[i] = next;
+            end_pos_[i]   = ++next;
+            labels_.push_back(labels.label_of(k, fa.payloads_[i]));
+            actions_.push_back(fa.actions_[i]);
+            leaves_.push_back(i);
+            if(k == Flat_kind::Regexp_name){
+                num_of_unresolved_++;
+            }
+        }else if(fa.num_of_children_[i]){
+            first_pos_[i] = first_pos_[*fa.children_begin(i)];
+            end_pos_[i]   = end_pos_[fa.children_end(i)[-1]];
+        }else{
+            first_pos_[i] = end_pos_[i] = next;
+        }
+    }
+    size_t total = 0;
+    for(uint32_t i = 0; i < n; ++i){
+        offsets_[i]  = total;
+        total       += num_of_words(i);
+    }
+    firstpos_.assign(total, 0);
+    lastpos_.assign(total, 0);
+}
+
+void Position_automaton::or_set(std::vector<uint64_t>& pool, uint32_t dst, uint32_t src)
+{
+    uint64_t*       d = pool.data() + offsets_[dst] + (first_word(src) - first_word(dst));
+    const uint64_t* s = pool.data() + offsets_[src];
+    size_t          m = num_of_words(src);
+    for(size_t k = 0; k < m; ++k){
+        d[k] |= s[k];
+    }
+}
+
+void Position_automaton::calc_sets(const Flat_ast& fa)
+{
+    size_t n = fa.size();
+    nullable_.assign(n, 0);
+    for(uint32_t i = 0; i < n; ++i){
+        Flat_kind       k     = fa.kind(i);
+        const uint32_t* begin = fa.children_begin(i);
+        const uint32_t* end   = fa.children_end(i);
+        if(is_leaf(k)){
+            size_t   p   = first_pos_[i];
+            uint64_t bit = uint64_t{1} << (p % Dense_bitset::bits_per_word);
+            firstpos_[offsets_[i]] = lastpos_[offsets_[i]] = bit;
+            continue;
+        }
+        switch(k){
+            case Flat_kind::Or:
+                for(auto c = begin; c != end; ++c){
+                    nullable_[i] |= nullable_[*c];
+                    or_set(firstpos_, i, *c);
+                    or_set(lastpos_,  i, *c);
+                }
+                break;
+            case Flat_kind::Concat:
+                nullable_[i] = 1;
+                for(auto c = begin; c != end; ++c){
+                    or_set(firstpos_, i, *c);
+                    if(!nullable_[*c]){
+                        nullable_[i] = 0;
+                        break;
+                    }
+                }
+                for(auto c = end; c != begin; --c){
+                    or_set(lastpos_, i, c[-1]);
+                    if(!nullable_[c[-1]]){
+                        break;
+                    }
+                }
+                break;
+            default:
+                /* Kleene, Positive, Optional: */
+                nullable_[i] = (k != Flat_kind::Positive) || nullable_[*begin];
+                or_set(firstpos_, i, *begin);
+                or_set(lastpos_,  i, *begin);
+                break;
+        }
+    }
+}
+
+template<typename F>
+void Position_automaton::for_each_follow_pair(const Flat_ast& fa, F f) const
+{
+    size_t n = fa.size();
+    for(uint32_t i = 0; i < n; ++i){
+        Flat_kind       k     = fa.kind(i);
+        const uint32_t* begin = fa.children_begin(i);
+        const uint32_t* end   = fa.children_end(i);
+        if((k == Flat_kind::Kleene) || (k == Flat_kind::Positive)){
+            for_each_in(lastpos_, *begin, [&](size_t p){f(p, *begin);});
+        }else if(k == Flat_kind::Concat){
+            for(auto c = begin; c + 1 < end; ++c){
+                for_each_in(lastpos_, *c, [&](size_t p){
+                    for(auto d = c + 1; d != end; ++d){
+                        if(num_of_words(*d)){
+                            f(p, *d);
+                        }
+                        if(!nullable_[*d]){
+                            break;
+                        }
+                    }
+                });
+            }
+        }
+    }
+}
+
+void Position_automaton::calc_follow(const Flat_ast& fa)
+{
+    size_t num_of_positions = labels_.size();
+    follow_begin_.assign(num_of_positions + 1, 0);
+    for_each_follow_pair(fa, [this](size_t p, uint32_t){follow_begin_[p + 1]++;});
+    for(size_t p = 0; p < num_of_positions; ++p){
+        follow_begin_[p + 1] += follow_begin_[p];
+    }
+    follow_nodes_.resize(follow_begin_[num_of_positions]);
+    std::vector<uint32_t> fill(follow_begin_.begin(), follow_begin_.end() - 1);
+    for_each_follow_pair(fa, [&](size_t p, uint32_t node){
+        follow_nodes_[fill[p]++] = node;
+    });
+}
+
+void Position_automaton::first_positions(Dense_bitset& out) const
+{
+    if(root_ != Flat_ast::no_node){
+        out.or_words(firstpos_.data() + offsets_[root_], first_word(root_),
+                     num_of_words(root_));
+    }
+}
+
+void Position_automaton::last_positions(Dense_bitset& out) const
+{
+    if(root_ != Flat_ast::no_node){
+        out.or_words(lastpos_.data() + offsets_[root_], first_word(root_),
+                     num_of_words(root_));
+    }
+}
+
+void Position_automaton::follow_positions(uint32_t p, Dense_bitset& out) const
+{
+    for(uint32_t j = follow_begin_[p]; j < follow_begin_[p + 1]; ++j){
+        uint32_t node = follow_nodes_[j];
+        out.or_words(firstpos_.data() + offsets_[node], first_word(node),
+                     num_of_words(node));
+    }
+}
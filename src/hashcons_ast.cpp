@@ -0,0 +1,213 @@
+/*
+    File:    hashcons_ast.cpp
+    Created: 19 October 2026 at 15:20 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <unordered_map>
+#include "../include/hashcons_ast.h"
+
+namespace ast{
+    static constexpr size_t initial_num_of_slots = 256;
+
+    static uint64_t mix(uint64_t h, uint64_t x)
+    {
+        h ^= x + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    Hashcons_builder::Hashcons_builder() : slots_(initial_num_of_slots, empty_slot) {}
+
+    bool Hashcons_builder::same_node(uint32_t        id,
+                                     Flat_kind       k,
+                                     const uint32_t* children,
+                                     size_t          num_of_children,
+                                     uint64_t        payload,
+                                     uint64_t        action) const
+    {
+        return (dag_.kind(id)             == k)               &&
+               (dag_.payloads_[id]        == payload)         &&
+               (dag_.actions_[id]         == action)          &&
+               (dag_.num_of_children_[id] == num_of_children) &&
+               std::equal(children, children + num_of_children, dag_.children_begin(id));
+    }
+
+    void Hashcons_builder::grow()
+    {
+        std::vector<uint32_t> new_slots(2 * slots_.size(), empty_slot);
+        size_t                mask = new_slots.size() - 1;
+        for(uint32_t id : slots_){
+            if(id == empty_slot){
+                continue;
+            }
+            size_t pos = hashes_[id] & mask;
+            while(new_slots[pos] != empty_slot){
+                pos = (pos + 1) & mask;
+            }
+            new_slots[pos] = id;
+        }
+        slots_.swap(new_slots);
+    }
+
+    uint32_t Hashcons_builder::intern(Flat_kind       k,
+                                      const uint32_t* children,
+                                      size_t          num_of_children,
+                                      uint64_t        payload,
+                                      uint64_t        action)
+    {
+        num_of_occurrences_++;
+        uint64_t h = mix(mix(mix(static_cast<uint64_t>(k), payload), action),
+                         num_of_children);
+        for(size_t i = 0; i < num_of_children; ++i){
+            h = mix(h, hashes_[children[i]]);
+        }
+
+        size_t mask = slots_.size() - 1;
+        size_t pos  = h & mask;
+        for(;;){
+            uint32_t id = slots_[pos];
+            if(id == empty_slot){
+                break;
+            }
+            if((hashes_[id] == h) &&
+               same_node(id, k, children, num_of_children, payload, action))
+            {
+                return id;
+            }
+            pos = (pos + 1) & mask;
+        }
+
+        uint32_t id = dag_.add_node(k, children, num_of_children, payload, action);
+        hashes_.push_back(h);
+        slots_[pos] = id;
+        if(2 * dag_.size() > slots_.size()){
+            grow();
+        }
+        return id;
+    }
+
+    uint32_t Hashcons_builder::add(const Flat_ast& fa)
+    {
+        if(fa.empty()){
+            roots_.push_back(Flat_ast::no_node);
+            return Flat_ast::no_node;
+        }
+        std::vector<uint32_t> ids(fa.size());
+        std::vector<uint32_t> children;
+        for(uint32_t i = 0; i < fa.size(); ++i){
+            children.clear();
+            for(const uint32_t* c = fa.children_begin(i); c != fa.children_end(i); ++c){
+                children.push_back(ids[*c]);
+            }
+            ids[i] = intern(fa.kind(i),
+                            children.data(),
+                            children.size(),
+                            fa.payloads_[i],
+                            fa.actions_[i]);
+        }
+        uint32_t root = ids[fa.root()];
+        roots_.push_back(root);
+        return root;
+    }
+
+    /*
+     * The tree is traversed with an explicit stack, as by the function to_flat. The
+     * identifiers of visited nodes are remembered, and a visited node is not traversed
+     * again.
+     */
+    struct Frame{
+        Ast_elem*  elem_;
+        Node_descr descr_;
+        size_t     next_child_;
+    };
+
+    uint32_t Hashcons_builder::add(const Regexp_ast& tree)
+    {
+        Ast_elem* root = tree.get_root();
+        if(!root){
+            roots_.push_back(Flat_ast::no_node);
+            return Flat_ast::no_node;
+        }
+        std::unordered_map<const Ast_elem*, uint32_t> visited;
+        std::vector<Frame>                            stack;
+        std::vector<uint32_t>                         ids;
+        stack.push_back(Frame{root, describe(root), 0});
+        while(!stack.empty()){
+            Frame& top = stack.back();
+            if(top.next_child_ < top.descr_.num_of_children_){
+                Ast_elem* child = top.descr_.children_[top.next_child_++];
+                auto      it    = visited.find(child);
+                if(it != visited.end()){
+                    ids.push_back(it->second);
+                }else{
+                    stack.push_back(Frame{child, describe(child), 0});
+                }
+                continue;
+            }
+            size_t   n  = top.descr_.num_of_children_;
+            uint32_t id = intern(top.descr_.kind_,
+                                 ids.data() + ids.size() - n,
+                                 n,
+                                 top.descr_.payload_,
+                                 top.elem_->action_idx_);
+            ids.resize(ids.size() - n);
+            ids.push_back(id);
+            visited[top.elem_] = id;
+            stack.pop_back();
+        }
+        roots_.push_back(ids.back());
+        return ids.back();
+    }
+
+    uint32_t Hashcons_builder::with_action(uint32_t id, uint64_t action)
+    {
+        if(id == Flat_ast::no_node){
+            return Flat_ast::no_node;
+        }
+        auto key = std::make_pair(id, action);
+        auto it  = with_action_.find(key);
+        if(it != with_action_.end()){
+            return it->second;
+        }
+        /* Nodes reachable from id are marked by one pass from id down to the node 0,
+         * and then are converted bottom-up, since children precede their parents. */
+        std::vector<uint8_t>  reachable(id + 1);
+        std::vector<uint32_t> result(id + 1);
+        std::vector<uint32_t> children;
+        reachable[id] = 1;
+        for(uint32_t i = id + 1; i-- > 0;){
+            if(!reachable[i]){
+                continue;
+            }
+            const uint32_t* last = dag_.children_end(i);
+            for(const uint32_t* c = dag_.children_begin(i); c != last; ++c){
+                reachable[*c] = 1;
+            }
+        }
+        for(uint32_t i = 0; i <= id; ++i){
+            if(!reachable[i]){
+                continue;
+            }
+            children.clear();
+            const uint32_t* last = dag_.children_end(i);
+            for(const uint32_t* c = dag_.children_begin(i); c != last; ++c){
+                children.push_back(result[*c]);
+            }
+            uint64_t act = children.empty() ? action : dag_.actions_[i];
+            result[i]    = intern(dag_.kind(i),
+                                  children.data(),
+                                  children.size(),
+                                  dag_.payloads_[i],
+                                  act);
+        }
+        with_action_[key] = result[id];
+        return result[id];
+    }
+};
@@ -8,12 +8,9 @@
 */
 
 #include "../include/idx_to_string.h"
-#include "../include/char_conv.h"
-std::string idx_to_string(std::shared_ptr<Char_trie> t,
-                          size_t                     idx,
-                          std::string                default_value)
+std::string idx_to_string(const std::shared_ptr<Char_trie>& t,
+                          size_t                            idx,
+                          const std::string&                default_value)
 {
-    auto u32str = t->get_string(idx);
-    std::string s = u32string_to_utf8(u32str);
-    return idx ? s : default_value;
+    return idx ? t->get_utf8_string(idx) : default_value;
 }
\ No newline at end of file
@@ -0,0 +1,281 @@
+/*
+    File:    lazy_dfa.cpp
+    Created: 20 October 2026 at 12:14 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include "../include/lazy_dfa.h"
+
+static uint64_t element_hash(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static bool is_important(const Nfa_state& st)
+{
+    return (st.kind_ == Nfa_state_kind::Char) || (st.kind_ == Nfa_state_kind::Match);
+}
+
+Lazy_dfa::Lazy_dfa(const Thompson_nfa& nfa, size_t memory_budget) :
+    nfa_(nfa), classes_(nfa.labels(), nfa.used_labels()), budget_(memory_budget)
+{
+    num_of_symbols_ = classes_.number_of_classes();
+    /* The row of transitions, the fields of the slot, and two entries of the hash
+     * table per slot: */
+    slot_size_      = num_of_symbols_ * sizeof(Transition) + 3 * sizeof(uint32_t) +
+                      2 * sizeof(uint8_t) + sizeof(uint64_t) +
+                      sizeof(std::vector<uint32_t>) + 2 * sizeof(uint32_t);
+    max_slots_      = std::max(min_slots, budget_ / slot_size_);
+    size_t table_size = 1;
+    while(table_size < 2 * max_slots_){
+        table_size *= 2;
+    }
+    table_.assign(table_size, no_slot);
+    closure_.reset(nfa_.size());
+}
+
+bool Lazy_dfa::same_set(uint32_t slot, size_t size) const
+{
+    const auto& set = sets_[slot];
+    if(set.size() != size){
+        return false;
+    }
+    for(uint32_t t : set){
+        if(!closure_.contains(t)){
+            return false;
+        }
+    }
+    return true;
+}
+
+void Lazy_dfa::table_insert(uint32_t slot)
+{
+    size_t mask = table_.size() - 1;
+    size_t pos  = hash_[slot] & mask;
+    while(table_[pos] != no_slot){
+        pos = (pos + 1) & mask;
+    }
+    table_[pos] = slot;
+}
+
+void Lazy_dfa::table_erase(uint32_t slot)
+{
+    size_t mask = table_.size() - 1;
+    size_t i    = hash_[slot] & mask;
+    while(table_[i] != slot){
+        i = (i + 1) & mask;
+    }
+    /* Deletion with backward shift: an entry after the hole is moved into the hole,
+     * unless its home position lies cyclically in (i, j]. */
+    for(;;){
+        table_[i] = no_slot;
+        size_t j  = i;
+        for(;;){
+            j = (j + 1) & mask;
+            if(table_[j] == no_slot){
+                return;
+            }
+            size_t k = hash_[table_[j]] & mask;
+            bool   stays = (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j));
+            if(!stays){
+                break;
+            }
+        }
+        table_[i] = table_[j];
+        i         = j;
+    }
+}
+
+uint32_t Lazy_dfa::choose_victim()
+{
+    for(;;){
+        if(hand_ >= used_){
+            hand_ = 0;
+        }
+        uint32_t s = static_cast<uint32_t>(hand_++);
+        if(!live_[s] || (s == pinned_)){
+            continue;
+        }
+        if(referenced_[s]){
+            referenced_[s] = 0;
+            continue;
+        }
+        return s;
+    }
+}
+
+void Lazy_dfa::evict(uint32_t slot)
+{
+    table_erase(slot);
+    live_[slot] = 0;
+    generation_[slot]++;
+    set_bytes_ -= sets_[slot].capacity() * sizeof(uint32_t);
+    std::vector<uint32_t>().swap(sets_[slot]);
+    free_.push_back(slot);
+    evictions_++;
+}
+
+uint32_t Lazy_dfa::new_slot(size_t set_size)
+{
+    size_t need = set_size * sizeof(uint32_t);
+    for(;;){
+        bool   has_free = !free_.empty();
+        size_t extra    = has_free ? 0 : slot_size_;
+        if((has_free || (used_ < max_slots_)) && (memory_used() + extra + need <= budget_)){
+            break;
+        }
+        size_t evictable = number_of_cached_states() - (pinned_ != no_slot);
+        if(!evictable){
+            break;
+        }
+        evict(choose_victim());
+    }
+    uint32_t slot;
+    if(!free_.empty()){
+        slot = free_.back();
+        free_.pop_back();
+        std::fill(rows_.begin() + slot * num_of_symbols_,
+                  rows_.begin() + (slot + 1) * num_of_symbols_,
+                  Transition());
+    }else{
+        slot = static_cast<uint32_t>(used_++);
+        rows_.resize(used_ * num_of_symbols_);
+        generation_.push_back(1);
+        referenced_.push_back(0);
+        live_.push_back(0);
+        accept_.push_back(Dfa::no_state);
+        hash_.push_back(0);
+        sets_.emplace_back();
+    }
+    return slot;
+}
+
+uint32_t Lazy_dfa::intern_closure()
+{
+    uint64_t h    = 0;
+    size_t   size = 0;
+    for(uint32_t t : closure_){
+        if(is_important(nfa_.state(t))){
+            h += element_hash(t);
+            size++;
+        }
+    }
+    if(!size){
+        return dead_state;
+    }
+
+    size_t mask = table_.size() - 1;
+    for(size_t pos = h & mask; table_[pos] != no_slot; pos = (pos + 1) & mask){
+        uint32_t slot = table_[pos];
+        if((hash_[slot] == h) && same_set(slot, size)){
+            return slot;
+        }
+    }
+
+    uint32_t slot = new_slot(size);
+    auto&    set  = sets_[slot];
+    uint32_t rule = Dfa::no_state;
+    set.reserve(size);
+    for(uint32_t t : closure_){
+        const Nfa_state& st = nfa_.state(t);
+        if(is_important(st)){
+            set.push_back(t);
+        }
+        if((st.kind_ == Nfa_state_kind::Match) && (st.label_ < rule)){
+            rule = st.label_;
+        }
+    }
+    set_bytes_        += set.capacity() * sizeof(uint32_t);
+    accept_[slot]      = rule;
+    hash_[slot]        = h;
+    live_[slot]        = 1;
+    referenced_[slot]  = 1;
+    table_insert(slot);
+    return slot;
+}
+
+uint32_t Lazy_dfa::start_state()
+{
+    bool valid = start_.generation_ &&
+                 ((start_.target_ == dead_state) ||
+                  (generation_[start_.target_] == start_.generation_));
+    if(valid){
+        return start_.target_;
+    }
+    uint32_t s = dead_state;
+    if(nfa_.start() != Thompson_nfa::no_state){
+        closure_.clear();
+        nfa_.add_closure(nfa_.start(), closure_, stack_);
+        s = intern_closure();
+    }
+    start_.target_     = s;
+    start_.generation_ = (s == dead_state) ? 1 : generation_[s];
+    return s;
+}
+
+uint32_t Lazy_dfa::compute_transition(uint32_t s, uint32_t cls)
+{
+    closure_.clear();
+    for(uint32_t t : sets_[s]){
+        const Nfa_state& st = nfa_.state(t);
+        if(st.kind_ != Nfa_state_kind::Char){
+            continue;
+        }
+        if(std::binary_search(classes_.label_classes_begin(st.label_),
+                              classes_.label_classes_end(st.label_), cls))
+        {
+            nfa_.add_closure(st.out1_, closure_, stack_);
+        }
+    }
+    return intern_closure();
+}
+
+Dfa_match Lazy_dfa::longest_match(const char32_t* begin, const char32_t* end)
+{
+    Dfa_match result;
+    uint32_t  s = start_state();
+    if(s == dead_state){
+        return result;
+    }
+    result.rule_id_ = accept_[s];
+    for(const char32_t* p = begin; p != end; ++p){
+        uint32_t cls = classes_.class_of(*p);
+        if(cls == Char_classes::no_class){
+            break;
+        }
+        referenced_[s]     = 1;
+        size_t     idx     = s * num_of_symbols_ + cls;
+        Transition e       = rows_[idx];
+        bool       valid   = e.generation_ &&
+                             ((e.target_ == dead_state) ||
+                              (generation_[e.target_] == e.generation_));
+        uint32_t   t;
+        if(valid){
+            hits_++;
+            t = e.target_;
+        }else{
+            misses_++;
+            pinned_             = s;
+            t                   = compute_transition(s, cls);
+            pinned_             = no_slot;
+            rows_[idx].target_     = t;
+            rows_[idx].generation_ = (t == dead_state) ? 1 : generation_[t];
+        }
+        if(t == dead_state){
+            break;
+        }
+        s = t;
+        if(accept_[s] != Dfa::no_state){
+            result.length_  = (p - begin) + 1;
+            result.rule_id_ = accept_[s];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,160 @@
+/*
+    File:    lexer_dfa.cpp
+    Created: 20 October 2026 at 13:21 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <cstdio>
+#include <string>
+#include "../include/lexer_dfa.h"
+#include "../include/simplify_ast.h"
+#include "../include/factor_literals.h"
+#include "../include/resolve_names.h"
+#include "../include/flat_ast.h"
+#include "../include/tagged_dfa.h"
+
+enum class Msg_name{
+    Shadowed_rule, Empty_token
+};
+
+static const char* messages[] = {
+    "Warning: the rule %s is never matched, since it is shadowed by tokens of "
+    "higher priority.\n",
+    "Error in the rule %s: a token cannot match the empty string.\n"
+};
+
+static constexpr Str_kinds keyword_bit   =
+    1u << static_cast<uint16_t>(Str_kind::Keyword_repres);
+static constexpr Str_kinds delimiter_bit =
+    1u << static_cast<uint16_t>(Str_kind::Delimiter_repres);
+
+/* This function appends to fa the concatenation of the characters of the string s. */
+static void literal_to_flat(const std::u32string& s, ast::Flat_ast& fa)
+{
+    std::vector<uint32_t> chars;
+    for(char32_t c : s){
+        chars.push_back(fa.add_node(ast::Flat_kind::Character, nullptr, 0, c, 0));
+    }
+    if(chars.size() > 1){
+        fa.add_node(ast::Flat_kind::Concat, chars.data(), chars.size(), 0, 0);
+    }
+}
+
+/* Keywords and delimiters from the scope; the empty string is not a token. */
+static void collect_literals(const Scope&              scope,
+                             const Errors_and_tries&   et,
+                             std::vector<Lexer_token>& tokens)
+{
+    scope.strsc_.for_each([&](size_t idx, const Str_attributes& attr){
+        Lexer_token tok;
+        if(attr.kind_ & keyword_bit){
+            tok.kind_ = Token_kind::Keyword;
+        }else if(attr.kind_ & delimiter_bit){
+            tok.kind_ = Token_kind::Delimiter;
+        }else{
+            return;
+        }
+        if(!et.strs_trie->get_length(idx)){
+            return;
+        }
+        tok.idx_  = idx;
+        tok.code_ = attr.code_;
+        tokens.push_back(tok);
+    });
+}
+
+static void warn_about_shadowed_rules(const Lexer_dfa& lexer, const Errors_and_tries& et)
+{
+    std::vector<uint8_t> accepted(lexer.tokens_.size(), 0);
+    for(uint32_t r : lexer.dfa_.accept_){
+        if(r != Dfa::no_state){
+            accepted[r] = 1;
+        }
+    }
+    for(size_t t = 0; t < lexer.tokens_.size(); ++t){
+        const auto& tok = lexer.tokens_[t];
+        if((tok.kind_ != Token_kind::Rule) || accepted[t]){
+            continue;
+        }
+        const auto& name = et.ids_trie->get_utf8_string(tok.idx_);
+        printf(messages[static_cast<unsigned>(Msg_name::Shadowed_rule)], name.c_str());
+    }
+}
+
+/* This function reports the token rule name, if its body fa matches the empty
+ * string: such a token would be returned without advancing the scanner. */
+static bool check_empty_token(const ast::Flat_ast&    fa,
+                              size_t                  name,
+                              const Errors_and_tries& et)
+{
+    if(!fa.size() || !ast::nullable(fa)[fa.root()]){
+        return true;
+    }
+    const auto& rule_name = et.ids_trie->get_utf8_string(name);
+    printf(messages[static_cast<unsigned>(Msg_name::Empty_token)], rule_name.c_str());
+    et.ec->increment_number_of_errors();
+    return false;
+}
+
+std::string token_name(const Lexer_dfa& lexer, size_t t, const Errors_and_tries& et)
+{
+    const auto& tok = lexer.tokens_[t];
+    switch(tok.kind_){
+        case Token_kind::Keyword:
+            return "Keyword_" + std::to_string(t);
+        case Token_kind::Delimiter:
+            return "Delimiter_" + std::to_string(t);
+        default:
+            return "Rule_" + et.ids_trie->get_utf8_string(tok.idx_);
+    }
+}
+
+bool build_lexer_dfa(const std::vector<Rule_info>&    rules,
+                     const Scope&                     scope,
+                     const Errors_and_tries&          et,
+                     const Trie_for_set_of_char32ptr& sets,
+                     Lexer_dfa&                       result)
+{
+    Regexp_name_resolver resolver(et);
+    for(const auto& ri : rules){
+        resolver.add_rule(ri);
+    }
+    if(!resolver.resolve()){
+        return false;
+    }
+
+    Lexer_dfa          lexer;
+    Tagged_dfa_builder builder(et, sets);
+    collect_literals(scope, et, lexer.tokens_);
+    ast::Flat_ast fa;
+    for(const auto& tok : lexer.tokens_){
+        fa.clear();
+        literal_to_flat(et.strs_trie->get_string(tok.idx_), fa);
+        builder.add_rule(fa, 0);
+    }
+    const auto& expanded = resolver.expanded_rules();
+    bool        ok       = true;
+    for(size_t r = 0; r < expanded.size(); ++r){
+        if(resolver.is_referenced(r)){
+            continue;
+        }
+        const auto& ri = expanded[r];
+        Lexer_token tok;
+        tok.kind_ = Token_kind::Rule;
+        tok.idx_  = ri.name_;
+        ast::Regexp_ast body = ast::factor_literals(ast::simplify(ri.body_, *sets));
+        fa                   = ast::to_flat(body);
+        ok                   = check_empty_token(fa, ri.name_, et) && ok;
+        builder.add_rule(fa, ri.name_);
+        lexer.tokens_.push_back(tok);
+    }
+    if(!ok || !builder.build(lexer.dfa_)){
+        return false;
+    }
+    warn_about_shadowed_rules(lexer, et);
+    result = std::move(lexer);
+    return true;
+}
@@ -0,0 +1,44 @@
+/*
+    File:    lower_rules.cpp
+    Created: 20 October 2026 at 09:34 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include "../include/lower_rules.h"
+#include "../include/simplify_ast.h"
+#include "../include/factor_literals.h"
+#include "../include/resolve_names.h"
+#include "../include/thompson_nfa.h"
+#include "../include/subset_construction.h"
+#include "../include/minimize_dfa.h"
+
+Dfa lower_resolved_rules(const std::vector<Rule_info>&    rules,
+                         const Trie_for_set_of_char32ptr& sets)
+{
+    Label_table  labels(sets);
+    Thompson_nfa nfa(labels);
+    for(size_t i = 0; i < rules.size(); ++i){
+        ast::Regexp_ast body = ast::factor_literals(ast::simplify(rules[i].body_, *sets));
+        nfa.add_rule(body, static_cast<uint32_t>(i));
+    }
+    return minimize(determinize(nfa));
+}
+
+bool lower_rules(const std::vector<Rule_info>&    rules,
+                 const Errors_and_tries&          et,
+                 const Trie_for_set_of_char32ptr& sets,
+                 Dfa&                             result)
+{
+    Regexp_name_resolver resolver(et);
+    for(const auto& ri : rules){
+        resolver.add_rule(ri);
+    }
+    if(!resolver.resolve()){
+        return false;
+    }
+    result = lower_resolved_rules(resolver.expanded_rules(), sets);
+    return true;
+}
@@ -0,0 +1,38 @@
+/*
+    File:    mapped_file.cpp
+    Created: 19 October 2026 at 10:11 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include "../include/mapped_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+Mapped_file::Mapped_file(const char* name)
+{
+    int fd = open(name, O_RDONLY);
+    if(fd < 0){
+        return;
+    }
+    struct stat st;
+    if((fstat(fd, &st) == 0) && (st.st_size > 0)){
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p != MAP_FAILED){
+            data_ = p;
+            size_ = st.st_size;
+        }
+    }
+    close(fd);
+}
+
+Mapped_file::~Mapped_file()
+{
+    if(data_){
+        munmap(data_, size_);
+    }
+}
@@ -0,0 +1,258 @@
+/*
+    File:    minimize_dfa.cpp
+    Created: 20 October 2026 at 08:57 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <map>
+#include <utility>
+#include "../include/minimize_dfa.h"
+#include "../include/refinable_partition.h"
+
+class Dfa_minimizer{
+public:
+    explicit Dfa_minimizer(const Dfa& dfa) : dfa_(dfa) {}
+    Dfa_minimizer(const Dfa_minimizer&) = delete;
+    ~Dfa_minimizer()                    = default;
+
+    Dfa minimize();
+private:
+    const Dfa&            dfa_;
+    /* Transitions: tails_[t] --labels_[t]--> heads_[t], with the set of actions
+     * actions_[t]: */
+    std::vector<uint32_t> tails_;
+    std::vector<uint32_t> heads_;
+    std::vector<uint32_t> labels_;
+    std::vector<uint32_t> actions_;
+    /* Transitions entering the state q are adj_[adj_begin_[q]], ...,
+     * adj_[adj_begin_[q + 1] - 1]: */
+    std::vector<uint32_t> adj_begin_;
+    std::vector<uint32_t> adj_;
+    std::vector<uint32_t> new_number_;
+    size_t                num_of_states_ = 0;
+    Refinable_partition   blocks_;
+    Refinable_partition   cords_;
+
+    void collect_transitions();
+    bool remove_irrelevant_states();
+    void make_adjacent();
+    void init_blocks();
+    void refine();
+    Dfa  build_result();
+};
+
+void Dfa_minimizer::collect_transitions()
+{
+    size_t n = dfa_.number_of_states();
+    size_t k = dfa_.number_of_symbols();
+    /* Reachable states are numbered in the order of the traversal. */
+    new_number_.assign(n, Dfa::no_state);
+    std::vector<uint32_t> order{dfa_.start_};
+    new_number_[dfa_.start_] = 0;
+    for(size_t i = 0; i < order.size(); ++i){
+        uint32_t s = order[i];
+        for(uint32_t sym = 0; sym < k; ++sym){
+            uint32_t t = dfa_.next(s, sym);
+            if(t == Dfa::no_state){
+                continue;
+            }
+            if(new_number_[t] == Dfa::no_state){
+                new_number_[t] = static_cast<uint32_t>(order.size());
+                order.push_back(t);
+            }
+            tails_.push_back(static_cast<uint32_t>(i));
+            heads_.push_back(new_number_[t]);
+            labels_.push_back(sym);
+            actions_.push_back(dfa_.has_actions() ? dfa_.trans_actions_[s * k + sym] : 0);
+        }
+    }
+    num_of_states_ = order.size();
+    /* From now on, new_number_ maps numbers of the traversal to original numbers. */
+    new_number_ = std::move(order);
+}
+
+void Dfa_minimizer::make_adjacent()
+{
+    adj_begin_.assign(num_of_states_ + 1, 0);
+    for(uint32_t h : heads_){
+        adj_begin_[h + 1]++;
+    }
+    for(size_t q = 0; q < num_of_states_; ++q){
+        adj_begin_[q + 1] += adj_begin_[q];
+    }
+    adj_.resize(heads_.size());
+    std::vector<uint32_t> fill(adj_begin_.begin(), adj_begin_.end() - 1);
+    for(size_t t = 0; t < heads_.size(); ++t){
+        adj_[fill[heads_[t]]++] = static_cast<uint32_t>(t);
+    }
+}
+
+bool Dfa_minimizer::remove_irrelevant_states()
+{
+    make_adjacent();
+    std::vector<uint8_t>  relevant(num_of_states_, 0);
+    std::vector<uint32_t> stack;
+    for(uint32_t q = 0; q < num_of_states_; ++q){
+        if(dfa_.accept_[new_number_[q]] != Dfa::no_state){
+            relevant[q] = 1;
+            stack.push_back(q);
+        }
+    }
+    while(!stack.empty()){
+        uint32_t q = stack.back();
+        stack.pop_back();
+        for(uint32_t j = adj_begin_[q]; j < adj_begin_[q + 1]; ++j){
+            uint32_t p = tails_[adj_[j]];
+            if(!relevant[p]){
+                relevant[p] = 1;
+                stack.push_back(p);
+            }
+        }
+    }
+    if(!relevant[0]){
+        return false;
+    }
+
+    std::vector<uint32_t> number(num_of_states_, Dfa::no_state);
+    std::vector<uint32_t> original;
+    for(uint32_t q = 0; q < num_of_states_; ++q){
+        if(relevant[q]){
+            number[q] = static_cast<uint32_t>(original.size());
+            original.push_back(new_number_[q]);
+        }
+    }
+    size_t m = 0;
+    for(size_t t = 0; t < tails_.size(); ++t){
+        if(relevant[tails_[t]] && relevant[heads_[t]]){
+            tails_[m]   = number[tails_[t]];
+            heads_[m]   = number[heads_[t]];
+            labels_[m]  = labels_[t];
+            actions_[m] = actions_[t];
+            m++;
+        }
+    }
+    tails_.resize(m);
+    heads_.resize(m);
+    labels_.resize(m);
+    actions_.resize(m);
+    num_of_states_ = original.size();
+    new_number_    = std::move(original);
+    make_adjacent();
+    return true;
+}
+
+void Dfa_minimizer::init_blocks()
+{
+    /* The key of a state is the accepted rule and the list of pairs (symbol, set of
+     * actions) for transitions with actions. Transitions are ordered by tails. */
+    using Key = std::pair<uint32_t, std::vector<uint64_t>>;
+    std::map<Key, uint32_t> groups;
+    std::vector<uint32_t>   group(num_of_states_);
+    size_t                  t = 0;
+    for(uint32_t q = 0; q < num_of_states_; ++q){
+        Key key;
+        key.first = dfa_.accept_[new_number_[q]];
+        for(; (t < tails_.size()) && (tails_[t] == q); ++t){
+            if(actions_[t]){
+                key.second.push_back((uint64_t{labels_[t]} << 32) | actions_[t]);
+            }
+        }
+        auto it = groups.find(key);
+        if(it == groups.end()){
+            it = groups.emplace(std::move(key), static_cast<uint32_t>(groups.size())).first;
+        }
+        group[q] = it->second;
+    }
+    blocks_.init(group.data(), num_of_states_, groups.size());
+    cords_.init(labels_.data(), labels_.size(), dfa_.number_of_symbols());
+}
+
+void Dfa_minimizer::refine()
+{
+    /* One block of the initial partition need not be used for splitting. */
+    uint32_t b = 1;
+    uint32_t c = 0;
+    while(c < cords_.number_of_sets()){
+        for(uint32_t i = cords_.first(c); i < cords_.end(c); ++i){
+            blocks_.mark(tails_[cords_.element(i)]);
+        }
+        blocks_.split();
+        ++c;
+        while(b < blocks_.number_of_sets()){
+            for(uint32_t i = blocks_.first(b); i < blocks_.end(b); ++i){
+                uint32_t q = blocks_.element(i);
+                for(uint32_t j = adj_begin_[q]; j < adj_begin_[q + 1]; ++j){
+                    cords_.mark(adj_[j]);
+                }
+            }
+            cords_.split();
+            ++b;
+        }
+    }
+}
+
+Dfa Dfa_minimizer::build_result()
+{
+    size_t m = blocks_.number_of_sets();
+    size_t k = dfa_.number_of_symbols();
+    /* Blocks are numbered in the order of the traversal from the start state. Since
+     * the states were numbered in this order, it suffices to number blocks in the
+     * order of their first states. */
+    std::vector<uint32_t> number(m, Dfa::no_state);
+    uint32_t              next = 0;
+    for(uint32_t q = 0; q < num_of_states_; ++q){
+        uint32_t& nb = number[blocks_.set_of(q)];
+        if(nb == Dfa::no_state){
+            nb = next++;
+        }
+    }
+
+    Dfa result;
+    result.classes_       = dfa_.classes_;
+    result.action_sets_   = dfa_.action_sets_;
+    result.start_         = 0;
+    result.start_actions_ = dfa_.start_actions_;
+    result.transitions_.assign(m * k, Dfa::no_state);
+    result.accept_.resize(m);
+    if(dfa_.has_actions()){
+        result.trans_actions_.assign(m * k, 0);
+    }
+    for(uint32_t q = 0; q < num_of_states_; ++q){
+        result.accept_[number[blocks_.set_of(q)]] = dfa_.accept_[new_number_[q]];
+    }
+    for(size_t t = 0; t < tails_.size(); ++t){
+        size_t idx = number[blocks_.set_of(tails_[t])] * k + labels_[t];
+        result.transitions_[idx] = number[blocks_.set_of(heads_[t])];
+        if(dfa_.has_actions()){
+            result.trans_actions_[idx] = actions_[t];
+        }
+    }
+    return result;
+}
+
+Dfa Dfa_minimizer::minimize()
+{
+    if(dfa_.start_ == Dfa::no_state){
+        return dfa_;
+    }
+    collect_transitions();
+    if(!remove_irrelevant_states()){
+        Dfa result;
+        result.classes_       = dfa_.classes_;
+        result.action_sets_   = dfa_.action_sets_;
+        result.start_actions_ = dfa_.start_actions_;
+        return result;
+    }
+    init_blocks();
+    refine();
+    return build_result();
+}
+
+Dfa minimize(const Dfa& dfa)
+{
+    Dfa_minimizer m(dfa);
+    return m.minimize();
+}
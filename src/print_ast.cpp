@@ -7,61 +7,86 @@
              gavvs1977@yandex.ru
 */
 
-// #define DEBUG
-// #ifdef DEBUG
-// #   include <cstdio>
-// #endif
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <vector>
 #include "../include/print_ast.h"
 #include "../include/print_char32.h"
-class To_string_visitor : public ast::Visitor{
+#include "../include/flat_ast.h"
+
+/*
+ * The class Ast_output accumulates the output in a string. If the output is directed
+ * into a file, then the string is written into the file and cleared as soon as its
+ * length exceeds flush_threshold, so the memory used does not depend on the size of
+ * the tree. Indentation is taken from the precomputed table of spaces, and numbers are
+ * converted by std::to_chars, so no temporary strings are created.
+ */
+class Ast_output{
 public:
-    To_string_visitor()                         = default;
-    To_string_visitor(const To_string_visitor&) = default;
-    virtual ~To_string_visitor()                = default;
+    explicit Ast_output(std::string& buf) : buf_(buf) {}
+    explicit Ast_output(FILE* f) : buf_(own_buf_), f_(f)
+    {
+        own_buf_.reserve(flush_threshold + flush_threshold / 4);
+    }
+    Ast_output(const Ast_output&) = delete;
+    ~Ast_output()
+    {
+        flush();
+    }
 
-//     std::string to_string(const std::shared_ptr<ast::Ast_elem>& root);
+    void put(const char* s, size_t n)
+    {
+        buf_.append(s, n);
+        if(f_ && (buf_.size() >= flush_threshold)){
+            flush();
+        }
+    }
 
-    std::string to_string(const ast::Regexp_ast& tree);
+    void put(const std::string& s)
+    {
+        put(s.data(), s.size());
+    }
 
-    virtual void visit(ast::Binary_op&             ref) override;
-    virtual void visit(ast::Unary_op&              ref) override;
-    virtual void visit(ast::Regexp_name_leaf&      ref) override;
-    virtual void visit(ast::Character_leaf&        ref) override;
-    virtual void visit(ast::Char_class_leaf&       ref) override;
-    virtual void visit(ast::Char_class_compl_leaf& ref) override;
+    template<size_t N>
+    void put(const char (&s)[N])
+    {
+        put(s, N - 1);
+    }
 
-private:
-    size_t      indent_     = 0;
-    std::string str_repres_;
-};
+    void put_number(uint64_t x)
+    {
+        char digits[24];
+        auto r = std::to_chars(digits, digits + sizeof(digits), x);
+        put(digits, r.ptr - digits);
+    }
 
-std::string ast2string(const ast::Regexp_ast& tree)
-{
-    std::string       result;
-    To_string_visitor v;
-//     result = v.to_string(tree.get_root());
-    result = v.to_string(tree);
-// #ifdef DEBUG
-//     printf("final str_repres_: %s\n", result.c_str());
-// #endif
-    return result;
-}
+    void put_indent(size_t n)
+    {
+        while(n > sizeof(spaces) - 1){
+            put(spaces, sizeof(spaces) - 1);
+            n -= sizeof(spaces) - 1;
+        }
+        put(spaces, n);
+    }
 
-std::string To_string_visitor::to_string(const ast::Regexp_ast& tree)
-{
-    indent_ = 0;
-    str_repres_.clear();
-    tree.traverse(*this);
-    return str_repres_;
-}
+    void flush()
+    {
+        if(f_ && !buf_.empty()){
+            fwrite(buf_.data(), 1, buf_.size(), f_);
+            buf_.clear();
+        }
+    }
+private:
+    static constexpr size_t flush_threshold = 1 << 16;
+    static constexpr char   spaces[]        =
+        "                                                                "
+        "                                                                ";
 
-// std::string To_string_visitor::to_string(const std::shared_ptr<ast::Ast_elem>& root)
-// {
-//     indent_ = 0;
-//     str_repres_.clear();
-//     root->accept(*this);
-//     return str_repres_;
-// }
+    std::string  own_buf_;
+    std::string& buf_;
+    FILE*        f_       = nullptr;
+};
 
 static constexpr size_t indent_increment = 4;
 
@@ -73,76 +98,274 @@ static const std::string unary_op_strs[] = {
     "{Kleene\n", "{Positive\n", "{Optional\n"
 };
 
-void To_string_visitor::visit(ast::Binary_op& ref)
+static const std::string leaf_strs[] = {
+    "{REgexp_name ", "{Char ", "{Char_class ", "{Char_class_complement "
+};
+
+static const char* kind_names[] = {
+    "Or",          "Concat",
+    "Kleene",      "Positive", "Optional",
+    "Regexp_name", "Char",     "Char_class", "Char_class_complement"
+};
+
+static const char* payload_names[] = {
+    "name", "char", "set", "set"
+};
+
+static bool is_leaf(ast::Flat_kind k)
 {
-    auto indent    =  std::string(indent_, ' ');
-    str_repres_ += indent + binary_op_strs[static_cast<unsigned>(ref.kind_)];
-    indent_     += indent_increment;
-    for(auto& child : ref.children_){
-        if(child){
-            child->accept(*this);
-        }else{
-            str_repres_ += std::string(indent_, ' ') + "{nullptr}\n";
+    using ast::Flat_kind;
+    return static_cast<unsigned>(k) >= static_cast<unsigned>(Flat_kind::Regexp_name);
+}
+
+static unsigned leaf_number(ast::Flat_kind k)
+{
+    using ast::Flat_kind;
+    return static_cast<unsigned>(k) - static_cast<unsigned>(Flat_kind::Regexp_name);
+}
+
+/*
+ * The tree is traversed with an explicit stack. For each node, the function enter is
+ * called before its children, the function separate is called between its children,
+ * and the function leave is called after its children. Absent children (nullptr) are
+ * printed by the function absent.
+ */
+struct Print_frame{
+    ast::Ast_elem*   elem_;
+    ast::Node_descr  descr_;
+    size_t           next_child_;
+    size_t           id_;
+};
+
+class Ast_printer{
+public:
+    Ast_printer(Ast_output& out, Ast_output_format fmt) : out_(out), fmt_(fmt) {}
+    Ast_printer(const Ast_printer&) = delete;
+    ~Ast_printer()                  = default;
+
+    void print(const ast::Regexp_ast& tree);
+private:
+    Ast_output&              out_;
+    Ast_output_format        fmt_;
+    std::vector<Print_frame> stack_;
+    size_t                   num_of_nodes_ = 0;
+
+    void enter(const Print_frame& fr);
+    void separate(const Print_frame& fr);
+    void leave(const Print_frame& fr);
+    void absent(const Print_frame* parent);
+    void push(ast::Ast_elem* elem);
+
+    void put_text_leaf(const Print_frame& fr);
+    void put_dot_edge(const Print_frame* parent, size_t id);
+    void put_dot_label(const Print_frame& fr);
+};
+
+void Ast_printer::push(ast::Ast_elem* elem)
+{
+    const Print_frame* parent = stack_.empty() ? nullptr : &stack_.back();
+    if(!elem){
+        absent(parent);
+        return;
+    }
+    stack_.push_back(Print_frame{elem, ast::describe(elem), 0, num_of_nodes_++});
+    enter(stack_.back());
+}
+
+void Ast_printer::print(const ast::Regexp_ast& tree)
+{
+    stack_.clear();
+    num_of_nodes_ = 0;
+    if(fmt_ == Ast_output_format::Dot){
+        out_.put("digraph ast{\n");
+    }
+    ast::Ast_elem* root = tree.get_root();
+    if(root){
+        push(root);
+    }else if(fmt_ == Ast_output_format::Json){
+        out_.put("null");
+    }
+    while(!stack_.empty()){
+        auto& top = stack_.back();
+        if(top.next_child_ < top.descr_.num_of_children_){
+            if(top.next_child_){
+                separate(top);
+            }
+            push(top.descr_.children_[top.next_child_++]);
+            continue;
         }
+        leave(top);
+        stack_.pop_back();
+    }
+    switch(fmt_){
+        case Ast_output_format::Text:
+            break;
+        case Ast_output_format::Json:
+            out_.put("\n");
+            break;
+        case Ast_output_format::Dot:
+            out_.put("}\n");
+            break;
     }
-    indent_     -= indent_increment;
-    str_repres_ += indent + "}\n";
-// #ifdef DEBUG
-//     printf("str_repres_: %s\n", str_repres_.c_str());
-// #endif
 }
 
-void To_string_visitor::visit(ast::Unary_op& ref)
+void Ast_printer::put_text_leaf(const Print_frame& fr)
 {
-    auto ind    =  std::string(indent_, ' ');
-    str_repres_ += ind + unary_op_strs[static_cast<unsigned>(ref.kind_)];
-    indent_     += indent_increment;
-    auto& child =  ref.child_;
-    if(child){
-        child->accept(*this);
+    ast::Flat_kind k = fr.descr_.kind_;
+    out_.put(leaf_strs[leaf_number(k)]);
+    if(k == ast::Flat_kind::Character){
+        out_.put(show_char32(static_cast<char32_t>(fr.descr_.payload_)));
     }else{
-        str_repres_ += std::string(indent_, ' ') + "{nullptr}\n";
+        out_.put_number(fr.descr_.payload_);
+    }
+    out_.put("[action_idx_ : ");
+    out_.put_number(fr.elem_->action_idx_);
+    out_.put("]}\n");
+}
+
+void Ast_printer::put_dot_edge(const Print_frame* parent, size_t id)
+{
+    if(!parent){
+        return;
+    }
+    out_.put("    n");
+    out_.put_number(parent->id_);
+    out_.put(" -> n");
+    out_.put_number(id);
+    out_.put(";\n");
+}
+
+void Ast_printer::put_dot_label(const Print_frame& fr)
+{
+    ast::Flat_kind k    = fr.descr_.kind_;
+    const char*    name = kind_names[static_cast<unsigned>(k)];
+    out_.put(name, strlen(name));
+    if(is_leaf(k)){
+        out_.put(" ");
+        if(k == ast::Flat_kind::Character){
+            for(char c : show_char32(static_cast<char32_t>(fr.descr_.payload_))){
+                if((c == '\"') || (c == '\\')){
+                    out_.put("\\");
+                }
+                out_.put(&c, 1);
+            }
+        }else{
+            out_.put_number(fr.descr_.payload_);
+        }
+    }
+    if(fr.elem_->action_idx_){
+        out_.put("\\naction ");
+        out_.put_number(fr.elem_->action_idx_);
+    }
+}
+
+void Ast_printer::enter(const Print_frame& fr)
+{
+    ast::Flat_kind k     = fr.descr_.kind_;
+    size_t         depth = stack_.size() - 1;
+    const char*    name  = kind_names[static_cast<unsigned>(k)];
+    switch(fmt_){
+        case Ast_output_format::Text:
+            out_.put_indent(depth * indent_increment);
+            if(is_leaf(k)){
+                put_text_leaf(fr);
+            }else if((k == ast::Flat_kind::Or) || (k == ast::Flat_kind::Concat)){
+                out_.put(binary_op_strs[static_cast<unsigned>(k)]);
+            }else{
+                unsigned u = static_cast<unsigned>(k) -
+                             static_cast<unsigned>(ast::Flat_kind::Kleene);
+                out_.put(unary_op_strs[u]);
+            }
+            break;
+        case Ast_output_format::Json:
+            out_.put("{\"kind\":\"");
+            out_.put(name, strlen(name));
+            out_.put("\",\"action\":");
+            out_.put_number(fr.elem_->action_idx_);
+            if(is_leaf(k)){
+                const char* pname = payload_names[leaf_number(k)];
+                out_.put(",\"");
+                out_.put(pname, strlen(pname));
+                out_.put("\":");
+                out_.put_number(fr.descr_.payload_);
+                out_.put("}");
+            }else{
+                out_.put(",\"children\":[");
+            }
+            break;
+        case Ast_output_format::Dot:
+            out_.put("    n");
+            out_.put_number(fr.id_);
+            out_.put(" [label=\"");
+            put_dot_label(fr);
+            out_.put("\"];\n");
+            put_dot_edge(depth ? &stack_[depth - 1] : nullptr, fr.id_);
+            break;
+    }
+}
+
+void Ast_printer::separate(const Print_frame& fr)
+{
+    if(fmt_ == Ast_output_format::Json){
+        out_.put(",");
+    }
+}
+
+void Ast_printer::leave(const Print_frame& fr)
+{
+    if(is_leaf(fr.descr_.kind_)){
+        return;
+    }
+    switch(fmt_){
+        case Ast_output_format::Text:
+            out_.put_indent((stack_.size() - 1) * indent_increment);
+            out_.put("}\n");
+            break;
+        case Ast_output_format::Json:
+            out_.put("]}");
+            break;
+        case Ast_output_format::Dot:
+            break;
     }
-    indent_     -= indent_increment;
-    str_repres_ += ind + "}\n";
 }
 
-void To_string_visitor::visit(ast::Regexp_name_leaf& ref)
+void Ast_printer::absent(const Print_frame* parent)
 {
-    str_repres_ += std::string(indent_, ' ')              +
-                   "{REgexp_name "                        +
-                   std::to_string(ref.regexp_name_index_) +
-                   "[action_idx_ : "                      +
-                   std::to_string(ref.action_idx_)       +
-                   "]}\n";
+    size_t id = num_of_nodes_++;
+    switch(fmt_){
+        case Ast_output_format::Text:
+            out_.put_indent(stack_.size() * indent_increment);
+            out_.put("{nullptr}\n");
+            break;
+        case Ast_output_format::Json:
+            out_.put("null");
+            break;
+        case Ast_output_format::Dot:
+            out_.put("    n");
+            out_.put_number(id);
+            out_.put(" [label=\"nullptr\"];\n");
+            put_dot_edge(parent, id);
+            break;
+    }
 }
 
-void To_string_visitor::visit(ast::Character_leaf& ref)
+void print_ast(const ast::Regexp_ast& tree, std::string& buf, Ast_output_format fmt)
 {
-    str_repres_ += std::string(indent_, ' ')     +
-                "{Char "                         +
-                show_char32(ref.c_)              +
-                "[action_idx_ : "                +
-                std::to_string(ref.action_idx_) +
-                "]}\n";
+    Ast_output  out(buf);
+    Ast_printer printer(out, fmt);
+    printer.print(tree);
 }
 
-void To_string_visitor::visit(ast::Char_class_leaf& ref)
+void print_ast(const ast::Regexp_ast& tree, FILE* f, Ast_output_format fmt)
 {
-    str_repres_ += std::string(indent_, ' ')              +
-                   "{Char_class "                         +
-                   std::to_string(ref.set_of_char_index_) +
-                   "[action_idx_ : "                      +
-                   std::to_string(ref.action_idx_)       +
-                   "]}\n";
+    Ast_output  out(f);
+    Ast_printer printer(out, fmt);
+    printer.print(tree);
 }
 
-void To_string_visitor::visit(ast::Char_class_compl_leaf& ref)
+std::string ast2string(const ast::Regexp_ast& tree)
 {
-    str_repres_ += std::string(indent_, ' ')              +
-                   "{Char_class_complement "              +
-                   std::to_string(ref.set_of_char_index_) +
-                   "[action_idx_ : "                      +
-                   std::to_string(ref.action_idx_)       +
-                   "]}\n";
-}
\ No newline at end of file
+    std::string result;
+    print_ast(tree, result);
+    return result;
+}
@@ -9,11 +9,13 @@
 
 #include <cstddef>
 #include "../include/print_regrule.h"
-#include "../include/idx_to_string.h"
 #include "../include/print_ast.h"
-void print_regrule(const Rule_info& ri, const std::shared_ptr<Char_trie>& t)
+void print_regrule(const Rule_info&                  ri,
+                   const std::shared_ptr<Char_trie>& t,
+                   Ast_output_format                 fmt)
 {
-    auto rname = idx_to_string(t, ri.name_);
-    auto rbody = ast2string(ri.body_);
-    printf("rule with name %s [%zu]:\n %s\n", rname.c_str(), ri.name_, rbody.c_str());
+    const auto& rname = t->get_utf8_string(ri.name_);
+    printf("rule with name %s [%zu]:\n ", rname.c_str(), ri.name_);
+    print_ast(ri.body_, stdout, fmt);
+    printf("\n");
 }
\ No newline at end of file
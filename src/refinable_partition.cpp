@@ -0,0 +1,63 @@
+/*
+    File:    refinable_partition.cpp
+    Created: 20 October 2026 at 08:25 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include "../include/refinable_partition.h"
+
+void Refinable_partition::init(const uint32_t* group, size_t n, size_t num_of_groups)
+{
+    elems_.resize(n);
+    loc_.resize(n);
+    sidx_.assign(group, group + n);
+    first_.assign(num_of_groups, 0);
+    end_.assign(num_of_groups, 0);
+    marked_.assign(num_of_groups, 0);
+    touched_.clear();
+
+    for(size_t e = 0; e < n; ++e){
+        end_[group[e]]++;
+    }
+    uint32_t sum = 0;
+    for(size_t s = 0; s < num_of_groups; ++s){
+        first_[s]  = sum;
+        sum       += end_[s];
+        end_[s]    = first_[s];
+    }
+    for(size_t e = 0; e < n; ++e){
+        uint32_t k = end_[group[e]]++;
+        elems_[k]  = static_cast<uint32_t>(e);
+        loc_[e]    = k;
+    }
+}
+
+void Refinable_partition::split()
+{
+    while(!touched_.empty()){
+        uint32_t s = touched_.back();
+        touched_.pop_back();
+        uint32_t j = first_[s] + marked_[s];
+        marked_[s] = 0;
+        if(j == end_[s]){
+            continue;
+        }
+        uint32_t z = static_cast<uint32_t>(first_.size());
+        if(j - first_[s] <= end_[s] - j){
+            first_.push_back(first_[s]);
+            end_.push_back(j);
+            first_[s] = j;
+        }else{
+            first_.push_back(j);
+            end_.push_back(end_[s]);
+            end_[s] = j;
+        }
+        marked_.push_back(0);
+        for(uint32_t k = first_[z]; k < end_[z]; ++k){
+            sidx_[elems_[k]] = z;
+        }
+    }
+}
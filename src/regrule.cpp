@@ -7,10 +7,10 @@
              gavvs1977@yandex.ru
 */
 
+#include <utility>
 #include "../include/regrule.h"
 #include "../include/main_lexem_info.h"
 #include "../include/belongs.h"
-#include "../include/idx_to_string.h"
 
 /*
  * Each rule of a regular definition has a form
@@ -136,25 +136,21 @@ static inline uint64_t check_id_attribute(Id_kind ikind, Id_attributes iattr)
 
 void Regrule::Impl::check_rule_name(size_t name_idx)
 {
-    auto&  id_scope        = scope_->idsc_;
-    auto   it              =  id_scope.find(name_idx);
-    if(it == id_scope.end()){
-        Id_attributes added_id_attr;
-        added_id_attr.kind_ = 1u << static_cast<uint8_t>(Id_kind::Regexp_name);
-        id_scope[name_idx]  = added_id_attr;
+    auto   p       = scope_->idsc_.insert_or_get(name_idx);
+    auto&  id_attr = *p.first;
+    if(p.second){
+        id_attr.kind_ = 1u << static_cast<uint8_t>(Id_kind::Regexp_name);
         return;
     }
-    auto existing_id_attr = it->second;
-    if(check_id_attribute(Id_kind::Regexp_name, it->second)){
-        auto str = idx_to_string(et_.ids_trie, name_idx);
+    if(check_id_attribute(Id_kind::Regexp_name, id_attr)){
+        const auto& str = et_.ids_trie->get_utf8_string(name_idx);
         printf(messages[static_cast<unsigned>(Msg_name::Already_defined_rule_name)],
                msc_->lexem_begin_line_number(),
                str.c_str());
         et_.ec->increment_number_of_errors();
         return;
     }
-    existing_id_attr.kind_ |= 1u << static_cast<uint8_t>(Id_kind::Regexp_name);
-    id_scope[name_idx]     =  existing_id_attr;
+    id_attr.kind_ |= 1u << static_cast<uint8_t>(Id_kind::Regexp_name);
 }
 
 void Regrule::Impl::proc_a()
@@ -195,7 +191,7 @@ Rule_info Regrule::Impl::compile()
     proc_a();
     proc_b();
     proc_c();
-    return current_rule_;
+    return std::move(current_rule_);
 }
 
 // Regrule::Impl::Proc Regrule::Impl::procs_[] = {
@@ -0,0 +1,250 @@
+/*
+    File:    resolve_names.cpp
+    Created: 19 October 2026 at 18:02 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <cstdio>
+#include <string>
+#include "../include/resolve_names.h"
+#include "../include/flat_ast.h"
+
+enum class Msg_name{
+    Undefined_regexp_name, Recursive_definition
+};
+
+static const char* messages[] = {
+    "Error in the rule %s: the regexp %%%s is not defined.\n",
+    "Error: recursive definition of regexps: %s.\n"
+};
+
+void Regexp_name_resolver::add_rule(const Rule_info& ri)
+{
+    auto p = rule_by_name_.insert(std::make_pair(ri.name_, rules_.size()));
+    if(!p.second){
+        has_duplicates_ = true;
+        return;
+    }
+    rules_.push_back(ri);
+}
+
+const Rule_info* Regexp_name_resolver::find_expanded(size_t name_idx) const
+{
+    auto it = rule_by_name_.find(name_idx);
+    if((it == rule_by_name_.end()) || (it->second >= expanded_.size())){
+        return nullptr;
+    }
+    return &expanded_[it->second];
+}
+
+bool Regexp_name_resolver::collect_references()
+{
+    bool ok = true;
+    refs_.assign(rules_.size(), std::vector<size_t>());
+    referenced_.assign(rules_.size(), 0);
+    for(size_t r = 0; r < rules_.size(); ++r){
+        auto fa = ast::to_flat(rules_[r].body_);
+        for(uint32_t i = 0; i < fa.size(); ++i){
+            if(fa.kind(i) != ast::Flat_kind::Regexp_name){
+                continue;
+            }
+            size_t name = static_cast<size_t>(fa.payloads_[i]);
+            auto   it   = rule_by_name_.find(name);
+            if(it != rule_by_name_.end()){
+                refs_[r].push_back(it->second);
+                referenced_[it->second] = 1;
+                continue;
+            }
+            const auto& rule_name = et_.ids_trie->get_utf8_string(rules_[r].name_);
+            const auto& ref_name  = et_.ids_trie->get_utf8_string(name);
+            printf(messages[static_cast<unsigned>(Msg_name::Undefined_regexp_name)],
+                   rule_name.c_str(),
+                   ref_name.c_str());
+            et_.ec->increment_number_of_errors();
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/*
+ * Depth-first search over the graph of references, with an explicit stack. The
+ * colour of a rule is 0, if the rule is not visited, 1, if the rule is on the stack,
+ * and 2, if all rules reachable from it are processed. An edge to a rule with the
+ * colour 1 closes a cycle, which consists of the rules of the stack from this rule up
+ * to the top. Rules are written into order when they are finished, i.e. every rule is
+ * written after all rules referenced by it.
+ */
+bool Regexp_name_resolver::sort_rules(std::vector<size_t>& order)
+{
+    bool                                   ok = true;
+    std::vector<uint8_t>                   colour(rules_.size(), 0);
+    std::vector<std::pair<size_t, size_t>> stack;
+    for(size_t start = 0; start < rules_.size(); ++start){
+        if(colour[start]){
+            continue;
+        }
+        colour[start] = 1;
+        stack.push_back(std::make_pair(start, 0));
+        while(!stack.empty()){
+            auto& top = stack.back();
+            size_t r  = top.first;
+            if(top.second == refs_[r].size()){
+                colour[r] = 2;
+                order.push_back(r);
+                stack.pop_back();
+                continue;
+            }
+            size_t next = refs_[r][top.second++];
+            if(!colour[next]){
+                colour[next] = 1;
+                stack.push_back(std::make_pair(next, 0));
+            }else if(colour[next] == 1){
+                std::string cycle;
+                size_t      k = stack.size();
+                while(stack[k - 1].first != next){
+                    k--;
+                }
+                for(; k <= stack.size(); ++k){
+                    size_t name = rules_[stack[k - 1].first].name_;
+                    cycle      += et_.ids_trie->get_utf8_string(name) + " -> ";
+                }
+                cycle += et_.ids_trie->get_utf8_string(rules_[next].name_);
+                printf(messages[static_cast<unsigned>(Msg_name::Recursive_definition)],
+                       cycle.c_str());
+                et_.ec->increment_number_of_errors();
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+class Name_expander : public ast::Visitor{
+public:
+    Name_expander(Regexp_name_resolver& resolver, ast::Ast_arena& arena) :
+        resolver_(resolver), arena_(arena) {}
+    Name_expander(const Name_expander&) = default;
+    virtual ~Name_expander()            = default;
+
+    ast::Ast_elem* expand(ast::Ast_elem* elem)
+    {
+        elem->accept(*this);
+        return result_;
+    }
+
+    void visit(ast::Binary_op&             ref) override;
+    void visit(ast::Unary_op&              ref) override;
+    void visit(ast::Regexp_name_leaf&      ref) override;
+    void visit(ast::Character_leaf&        ref) override;
+    void visit(ast::Char_class_leaf&       ref) override;
+    void visit(ast::Char_class_compl_leaf& ref) override;
+private:
+    Regexp_name_resolver& resolver_;
+    ast::Ast_arena&       arena_;
+    ast::Ast_elem*        result_ = nullptr;
+};
+
+void Name_expander::visit(ast::Binary_op& ref)
+{
+    bool          modified = false;
+    ast::Children children(arena_.resource());
+    for(ast::Ast_elem* c : ref.children_){
+        ast::Ast_elem* e = expand(c);
+        modified         = modified || (e != c);
+        children.push_back(e);
+    }
+    if(modified){
+        result_              = arena_.create<ast::Binary_op>(ref.kind_,
+                                                        std::move(children));
+        result_->action_idx_ = ref.action_idx_;
+    }else{
+        result_              = &ref;
+    }
+}
+
+void Name_expander::visit(ast::Unary_op& ref)
+{
+    ast::Ast_elem* child = expand(ref.child_);
+    if(child == ref.child_){
+        result_              = &ref;
+    }else{
+        result_              = arena_.create<ast::Unary_op>(ref.kind_, child);
+        result_->action_idx_ = ref.action_idx_;
+    }
+}
+
+void Name_expander::visit(ast::Regexp_name_leaf& ref)
+{
+    size_t      r    = resolver_.rule_by_name_[ref.regexp_name_index_];
+    const auto& body = resolver_.expanded_[r].body_;
+    if(!ref.action_idx_){
+        arena_.retain(body.get_arena());
+        result_ = body.get_root();
+        return;
+    }
+    auto key = std::make_pair(r, ref.action_idx_);
+    auto it  = resolver_.with_action_.find(key);
+    if(it == resolver_.with_action_.end()){
+        /* The body is copied through the DAG of the resolver rather than through
+         * to_flat, which would unfold the bodies of rules shared in the body. */
+        auto&    dag  = resolver_.dag_;
+        uint32_t id   = dag.with_action(dag.add(body), ref.action_idx_);
+        auto     copy = ast::from_flat(dag.dag(), id, resolver_.et_.memory_resource);
+        it = resolver_.with_action_.insert(std::make_pair(key, copy)).first;
+    }
+    arena_.retain(it->second.get_arena());
+    result_ = it->second.get_root();
+}
+
+void Name_expander::visit(ast::Character_leaf& ref)
+{
+    result_ = &ref;
+}
+
+void Name_expander::visit(ast::Char_class_leaf& ref)
+{
+    result_ = &ref;
+}
+
+void Name_expander::visit(ast::Char_class_compl_leaf& ref)
+{
+    result_ = &ref;
+}
+
+void Regexp_name_resolver::expand(size_t r)
+{
+    const auto& body = rules_[r].body_;
+    auto&       dst  = expanded_[r];
+    dst.name_        = rules_[r].name_;
+    if(!body.get_root() || refs_[r].empty()){
+        dst.body_ = body;
+        return;
+    }
+    Name_expander expander(*this, *body.get_arena());
+    dst.body_ = ast::Regexp_ast(body.get_arena(), expander.expand(body.get_root()));
+}
+
+bool Regexp_name_resolver::resolve()
+{
+    expanded_.clear();
+    with_action_.clear();
+    dag_ = ast::Hashcons_builder();
+    if(has_duplicates_){
+        return false;
+    }
+    std::vector<size_t> order;
+    bool                defined    = collect_references();
+    bool                not_cyclic  = sort_rules(order);
+    if(!defined || !not_cyclic){
+        return false;
+    }
+    expanded_.resize(rules_.size());
+    for(size_t r : order){
+        expand(r);
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+/*
+    File:    session.cpp
+    Created: 19 October 2026 at 12:21 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include "../include/session.h"
+
+static std::unique_ptr<std::pmr::memory_resource> create_resource(Memory_resource_kind k)
+{
+    std::unique_ptr<std::pmr::memory_resource> result;
+    switch(k){
+        case Memory_resource_kind::Monotonic:
+            result = std::make_unique<std::pmr::monotonic_buffer_resource>();
+            break;
+        case Memory_resource_kind::Pool:
+            result = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+            break;
+        case Memory_resource_kind::Malloc:
+            break;
+    }
+    return result;
+}
+
+template<typename T, typename... Args>
+static std::shared_ptr<T> make_in(std::pmr::memory_resource* mr, Args&&... args)
+{
+    std::pmr::polymorphic_allocator<T> alloc(mr);
+    return std::allocate_shared<T>(alloc, std::forward<Args>(args)...);
+}
+
+Session::Session(Memory_resource_kind kind) :
+    kind_(kind), own_resource_(create_resource(kind))
+{
+    resource_           = own_resource_ ? own_resource_.get() :
+                                          std::pmr::new_delete_resource();
+    et_.memory_resource = resource_;
+    et_.ec              = make_in<Error_count>(resource_);
+    et_.ids_trie        = make_in<Char_trie>(resource_, resource_);
+    et_.strs_trie       = make_in<Char_trie>(resource_, resource_);
+    scope_              = make_in<Scope>(resource_, resource_);
+    sets_trie_          = make_in<Trie_for_set_of_char32>(resource_, resource_);
+}
+
+Session::~Session()
+{
+    /* Objects allocated from the resource must be destroyed before the resource. */
+    sets_trie_.reset();
+    scope_.reset();
+    et_.ids_trie.reset();
+    et_.strs_trie.reset();
+    et_.ec.reset();
+}
@@ -0,0 +1,251 @@
+/*
+    File:    simplify_ast.cpp
+    Created: 19 October 2026 at 16:10 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <set>
+#include <vector>
+#include "../include/simplify_ast.h"
+#include "../include/flat_ast.h"
+
+namespace ast{
+    static bool is_unary(Flat_kind k)
+    {
+        return (k == Flat_kind::Kleene) || (k == Flat_kind::Positive) ||
+               (k == Flat_kind::Optional);
+    }
+
+    static bool is_char_or_class(Flat_kind k)
+    {
+        return (k == Flat_kind::Character) || (k == Flat_kind::Char_class);
+    }
+
+    /* Structural equality of subtrees, taking into account actions. */
+    static bool same_tree(Ast_elem* a, Ast_elem* b)
+    {
+        if(a == b){
+            return true;
+        }
+        auto da = describe(a);
+        auto db = describe(b);
+        if((da.kind_            != db.kind_)    || (da.payload_ != db.payload_) ||
+           (da.num_of_children_ != db.num_of_children_)                        ||
+           (a->action_idx_      != b->action_idx_))
+        {
+            return false;
+        }
+        for(size_t i = 0; i < da.num_of_children_; ++i){
+            if(!same_tree(da.children_[i], db.children_[i])){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    class Simplifier : public Visitor{
+    public:
+        Simplifier(Ast_arena& arena, Trie_for_set_of_char32& sets) :
+            arena_(arena), sets_(sets) {}
+        Simplifier(const Simplifier&) = default;
+        virtual ~Simplifier()         = default;
+
+        Ast_elem* simplify(Ast_elem* elem)
+        {
+            elem->accept(*this);
+            return result_;
+        }
+
+        void visit(Binary_op&             ref) override;
+        void visit(Unary_op&              ref) override;
+        void visit(Regexp_name_leaf&      ref) override;
+        void visit(Character_leaf&        ref) override;
+        void visit(Char_class_leaf&       ref) override;
+        void visit(Char_class_compl_leaf& ref) override;
+    private:
+        Ast_arena&              arena_;
+        Trie_for_set_of_char32& sets_;
+        Ast_elem*               result_ = nullptr;
+
+        void remove_repeated(Children& children);
+        void merge_classes(Children& children);
+    };
+
+    void Simplifier::visit(Regexp_name_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Simplifier::visit(Character_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Simplifier::visit(Char_class_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    void Simplifier::visit(Char_class_compl_leaf& ref)
+    {
+        result_ = &ref;
+    }
+
+    /*
+     * If the child is x*, x+ or x?, then the pair of closures is replaced by one
+     * closure of x, in accordance with the following table (rows are indexed by the
+     * outer closure, columns are indexed by the inner closure):
+     *              *   +   ?
+     *          *   *   *   *
+     *          +   *   +   *
+     *          ?   *   *   ?
+     */
+    static const Unary_op_kind combined_closure[3][3] = {
+        {Unary_op_kind::Kleene, Unary_op_kind::Kleene,   Unary_op_kind::Kleene  },
+        {Unary_op_kind::Kleene, Unary_op_kind::Positive, Unary_op_kind::Kleene  },
+        {Unary_op_kind::Kleene, Unary_op_kind::Kleene,   Unary_op_kind::Optional}
+    };
+
+    void Simplifier::visit(Unary_op& ref)
+    {
+        Ast_elem*     child = simplify(ref.child_);
+        Unary_op_kind k     = ref.kind_;
+        auto          d     = describe(child);
+        while(is_unary(d.kind_) && !child->action_idx_){
+            unsigned inner = static_cast<unsigned>(d.kind_) -
+                             static_cast<unsigned>(Flat_kind::Kleene);
+            k              = combined_closure[static_cast<unsigned>(k)][inner];
+            child          = d.children_[0];
+            d              = describe(child);
+        }
+        if((child == ref.child_) && (k == ref.kind_)){
+            result_              = &ref;
+        }else{
+            result_              = arena_.create<Unary_op>(k, child);
+            result_->action_idx_ = ref.action_idx_;
+        }
+    }
+
+    void Simplifier::remove_repeated(Children& children)
+    {
+        Children unique(arena_.resource());
+        for(Ast_elem* c : children){
+            bool repeated = false;
+            for(Ast_elem* u : unique){
+                if(same_tree(c, u)){
+                    repeated = true;
+                    break;
+                }
+            }
+            if(!repeated){
+                unique.push_back(c);
+            }
+        }
+        children = std::move(unique);
+    }
+
+    /*
+     * Alternatives which are characters or character classes are grouped by actions.
+     * Each group of two or more alternatives is replaced by one character class placed
+     * at the position of the first alternative of the group.
+     */
+    void Simplifier::merge_classes(Children& children)
+    {
+        std::vector<size_t> group_sizes(children.size(), 0);
+        std::vector<size_t> group_of(children.size(), children.size());
+        for(size_t i = 0; i < children.size(); ++i){
+            if(!is_char_or_class(describe(children[i]).kind_)){
+                continue;
+            }
+            size_t g = i;
+            for(size_t j = 0; j < i; ++j){
+                if((group_of[j] == j) &&
+                   (children[j]->action_idx_ == children[i]->action_idx_))
+                {
+                    g = j;
+                    break;
+                }
+            }
+            group_of[i] = g;
+            group_sizes[g]++;
+        }
+
+        Children result(arena_.resource());
+        for(size_t i = 0; i < children.size(); ++i){
+            size_t g = group_of[i];
+            if((g == children.size()) || (group_sizes[g] < 2)){
+                result.push_back(children[i]);
+                continue;
+            }
+            if(g != i){
+                continue;
+            }
+            std::set<char32_t> s;
+            for(size_t j = i; j < children.size(); ++j){
+                if(group_of[j] != g){
+                    continue;
+                }
+                auto d = describe(children[j]);
+                if(d.kind_ == Flat_kind::Character){
+                    s.insert(static_cast<char32_t>(d.payload_));
+                }else{
+                    auto t = sets_.get_set(d.payload_);
+                    s.insert(t.begin(), t.end());
+                }
+            }
+            Ast_elem* leaf    = arena_.create<Char_class_leaf>(sets_.insertSet(s));
+            leaf->action_idx_ = children[i]->action_idx_;
+            result.push_back(leaf);
+        }
+        children = std::move(result);
+    }
+
+    void Simplifier::visit(Binary_op& ref)
+    {
+        Flat_kind kind     = (ref.kind_ == Binary_op_kind::Or) ? Flat_kind::Or :
+                                                                 Flat_kind::Concat;
+        bool      modified = false;
+        Children  children(arena_.resource());
+        for(Ast_elem* c : ref.children_){
+            Ast_elem* s = simplify(c);
+            auto      d = describe(s);
+            modified    = modified || (s != c);
+            if((d.kind_ == kind) && !s->action_idx_){
+                modified = true;
+                for(size_t i = 0; i < d.num_of_children_; ++i){
+                    children.push_back(d.children_[i]);
+                }
+            }else{
+                children.push_back(s);
+            }
+        }
+        if(kind == Flat_kind::Or){
+            size_t n = children.size();
+            remove_repeated(children);
+            merge_classes(children);
+            modified = modified || (children.size() != n);
+        }
+        if((children.size() == 1) && !ref.action_idx_){
+            result_ = children[0];
+        }else if(modified){
+            result_              = arena_.create<Binary_op>(ref.kind_,
+                                                            std::move(children));
+            result_->action_idx_ = ref.action_idx_;
+        }else{
+            result_              = &ref;
+        }
+    }
+
+    Regexp_ast simplify(const Regexp_ast& tree, Trie_for_set_of_char32& sets)
+    {
+        Ast_elem* root = tree.get_root();
+        if(!root){
+            return tree;
+        }
+        Simplifier simplifier(*tree.get_arena(), sets);
+        return Regexp_ast(tree.get_arena(), simplifier.simplify(root));
+    }
+};
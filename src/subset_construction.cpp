@@ -0,0 +1,204 @@
+/*
+    File:    subset_construction.cpp
+    Created: 19 October 2026 at 23:21 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include "../include/subset_construction.h"
+
+static uint64_t element_hash(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static bool is_important(const Nfa_state& st)
+{
+    return (st.kind_ == Nfa_state_kind::Char) || (st.kind_ == Nfa_state_kind::Match);
+}
+
+Subset_constructor::Subset_constructor(const Thompson_nfa& nfa) : nfa_(nfa)
+{
+}
+
+void Subset_constructor::build_alphabet()
+{
+    dfa_.classes_ = Char_classes(nfa_.labels(), nfa_.used_labels());
+}
+
+bool Subset_constructor::same_set(uint32_t s, size_t size) const
+{
+    size_t begin = set_begin_[s];
+    size_t end   = set_begin_[s + 1];
+    if(end - begin != size){
+        return false;
+    }
+    for(size_t k = begin; k < end; ++k){
+        if(!closure_.contains(pool_[k])){
+            return false;
+        }
+    }
+    return true;
+}
+
+void Subset_constructor::grow_slots()
+{
+    std::vector<uint32_t> new_slots(slots_.size() * 2, empty_slot);
+    size_t                mask = new_slots.size() - 1;
+    for(uint32_t id : slots_){
+        if(id == empty_slot){
+            continue;
+        }
+        size_t pos = set_hash_[id] & mask;
+        while(new_slots[pos] != empty_slot){
+            pos = (pos + 1) & mask;
+        }
+        new_slots[pos] = id;
+    }
+    slots_ = std::move(new_slots);
+}
+
+uint32_t Subset_constructor::intern_closure()
+{
+    uint64_t h    = 0;
+    size_t   size = 0;
+    for(uint32_t t : closure_){
+        if(is_important(nfa_.state(t))){
+            h += element_hash(t);
+            size++;
+        }
+    }
+
+    size_t mask = slots_.size() - 1;
+    size_t pos  = h & mask;
+    for(;;){
+        uint32_t id = slots_[pos];
+        if(id == empty_slot){
+            break;
+        }
+        if((set_hash_[id] == h) && same_set(id, size)){
+            return id;
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    uint32_t id   = static_cast<uint32_t>(set_hash_.size());
+    uint32_t rule = Dfa::no_state;
+    for(uint32_t t : closure_){
+        const Nfa_state& st = nfa_.state(t);
+        if(is_important(st)){
+            pool_.push_back(t);
+        }
+        if((st.kind_ == Nfa_state_kind::Match) && (st.label_ < rule)){
+            rule = st.label_;
+        }
+    }
+    set_begin_.push_back(pool_.size());
+    set_hash_.push_back(h);
+    dfa_.accept_.push_back(rule);
+    slots_[pos] = id;
+    if(2 * set_hash_.size() > slots_.size()){
+        grow_slots();
+    }
+    return id;
+}
+
+uint32_t Subset_constructor::intern_actions()
+{
+    for(uint32_t t : closure_){
+        const Nfa_state& st = nfa_.state(t);
+        if((st.kind_ == Nfa_state_kind::Eps) && st.action_){
+            actions_.push_back(st.action_);
+        }
+    }
+    if(actions_.empty()){
+        return 0;
+    }
+    std::sort(actions_.begin(), actions_.end());
+    actions_.erase(std::unique(actions_.begin(), actions_.end()), actions_.end());
+    auto it = action_ids_.find(actions_);
+    if(it != action_ids_.end()){
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(dfa_.action_sets_.size());
+    dfa_.action_sets_.push_back(actions_);
+    action_ids_[actions_] = id;
+    return id;
+}
+
+void Subset_constructor::add_row(uint32_t s)
+{
+    size_t num_of_symbols = dfa_.number_of_symbols();
+    size_t row            = s * num_of_symbols;
+    dfa_.transitions_.resize(row + num_of_symbols, Dfa::no_state);
+    dfa_.trans_actions_.resize(row + num_of_symbols, 0);
+
+    touched_.clear();
+    for(size_t k = set_begin_[s]; k < set_begin_[s + 1]; ++k){
+        uint32_t         t  = pool_[k];
+        const Nfa_state& st = nfa_.state(t);
+        if(st.kind_ != Nfa_state_kind::Char){
+            continue;
+        }
+        const uint32_t* end = dfa_.classes_.label_classes_end(st.label_);
+        for(auto c = dfa_.classes_.label_classes_begin(st.label_); c != end; ++c){
+            if(buckets_[*c].empty()){
+                touched_.push_back(*c);
+            }
+            buckets_[*c].push_back(t);
+        }
+    }
+
+    for(uint32_t sym : touched_){
+        closure_.clear();
+        actions_.clear();
+        for(uint32_t t : buckets_[sym]){
+            const Nfa_state& st = nfa_.state(t);
+            if(st.action_){
+                actions_.push_back(st.action_);
+            }
+            nfa_.add_closure(st.out1_, closure_, stack_);
+        }
+        buckets_[sym].clear();
+        uint32_t target                = intern_closure();
+        dfa_.transitions_[row + sym]   = target;
+        dfa_.trans_actions_[row + sym] = intern_actions();
+    }
+}
+
+Dfa Subset_constructor::build()
+{
+    build_alphabet();
+    buckets_.resize(dfa_.number_of_symbols());
+    closure_.reset(nfa_.size());
+    slots_.assign(256, empty_slot);
+    set_begin_.assign(1, 0);
+    dfa_.action_sets_.assign(1, std::vector<uint64_t>());
+
+    if(nfa_.start() != Thompson_nfa::no_state){
+        closure_.clear();
+        actions_.clear();
+        nfa_.add_closure(nfa_.start(), closure_, stack_);
+        dfa_.start_         = intern_closure();
+        dfa_.start_actions_ = intern_actions();
+        for(uint32_t s = 0; s < dfa_.number_of_states(); ++s){
+            add_row(s);
+        }
+    }
+    if(dfa_.action_sets_.size() == 1){
+        dfa_.trans_actions_.clear();
+    }
+    return std::move(dfa_);
+}
+
+Dfa determinize(const Thompson_nfa& nfa)
+{
+    Subset_constructor sc(nfa);
+    return sc.build();
+}
@@ -0,0 +1,429 @@
+/*
+    File:    table_scanner_gen.cpp
+    Created: 20 October 2026 at 18:07 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+#include "../include/table_scanner_gen.h"
+#include "../include/tagged_dfa.h"
+
+/* Candidates for the default state of a state, and the maximal length of the chain of
+ * default states, i.e. the maximal number of extra probes of a lookup: */
+static constexpr size_t   max_candidates    = 32;
+static constexpr uint32_t max_default_depth = 2;
+
+static constexpr size_t   numbers_per_line  = 16;
+
+/* The number of bits for numbers from 0 to n - 1 and the sentinel, which is the
+ * maximal value of the type: */
+static unsigned bits_for_count(size_t n)
+{
+    if(n <= UINT8_MAX){
+        return 8;
+    }
+    return (n <= UINT16_MAX) ? 16 : 32;
+}
+
+/* The number of bits for numbers from 0 to max_value, without a sentinel: */
+static unsigned bits_for_value(size_t max_value)
+{
+    return bits_for_count(max_value + 1);
+}
+
+/* The sentinel UINT32_MAX is stored as the maximal value of the narrower type: */
+static uint32_t narrow(uint32_t value, unsigned bits)
+{
+    if((value != UINT32_MAX) || (bits == 32)){
+        return value;
+    }
+    return (uint32_t{1} << bits) - 1;
+}
+
+static std::string type_of(unsigned bits)
+{
+    return "uint" + std::to_string(bits) + "_t";
+}
+
+class Table_scanner_generator{
+public:
+    Table_scanner_generator(const Lexer_dfa& lexer, const Errors_and_tries& et) :
+        lexer_(lexer), dfa_(lexer.dfa_), et_(et) {}
+    Table_scanner_generator(const Table_scanner_generator&) = delete;
+    ~Table_scanner_generator()                              = default;
+
+    std::string generate(const std::string& name, Table_scanner_stats& stats);
+private:
+    /* An entry of a row: the class and the target. */
+    using Entry = std::pair<uint32_t, uint32_t>;
+
+    const Lexer_dfa&                lexer_;
+    const Dfa&                      dfa_;
+    const Errors_and_tries&         et_;
+    size_t                          n_ = 0;
+    size_t                          k_ = 0;
+    std::vector<uint32_t>           default_;
+    std::vector<uint32_t>           depth_;
+    std::vector<std::vector<Entry>> entries_;
+    std::vector<uint32_t>           base_;
+    std::vector<uint32_t>           next_;
+    std::vector<uint32_t>           check_;
+    std::vector<uint32_t>           actions_;
+    std::string                     out_;
+
+    /* Actions: the used indices of actions in the prefix tree of identifiers, sorted,
+     * and the flattened sets of actions (see comb_scanner.h): */
+    std::vector<uint64_t>           action_names_;
+    std::vector<uint32_t>           action_set_begin_;
+    std::vector<uint32_t>           action_token_;
+    std::vector<uint32_t>           action_id_;
+
+    uint32_t actions_of(uint32_t s, uint32_t c) const;
+    uint32_t most_frequent_target(uint32_t s) const;
+    size_t   number_of_differences(uint32_t s, uint32_t d) const;
+    void     flatten_actions();
+    void     choose_defaults();
+    void     place_rows();
+    void     emit_array(const std::string&           type,
+                        const std::string&           name,
+                        const std::vector<uint32_t>& values,
+                        unsigned                     bits);
+};
+
+uint32_t Table_scanner_generator::actions_of(uint32_t s, uint32_t c) const
+{
+    return dfa_.has_actions() ? dfa_.trans_actions_[s * k_ + c] : 0;
+}
+
+void Table_scanner_generator::flatten_actions()
+{
+    for(const auto& set : dfa_.action_sets_){
+        for(uint64_t tag : set){
+            action_names_.push_back(tag_action(tag));
+        }
+    }
+    std::sort(action_names_.begin(), action_names_.end());
+    action_names_.erase(std::unique(action_names_.begin(), action_names_.end()),
+                        action_names_.end());
+    for(const auto& set : dfa_.action_sets_){
+        action_set_begin_.push_back(static_cast<uint32_t>(action_token_.size()));
+        for(uint64_t tag : set){
+            auto it = std::lower_bound(action_names_.begin(), action_names_.end(),
+                                       tag_action(tag));
+            action_token_.push_back(tag_rule(tag));
+            action_id_.push_back(static_cast<uint32_t>(it - action_names_.begin()));
+        }
+    }
+    action_set_begin_.push_back(static_cast<uint32_t>(action_token_.size()));
+}
+
+uint32_t Table_scanner_generator::most_frequent_target(uint32_t s) const
+{
+    std::vector<uint32_t> row(dfa_.transitions_.begin() + s * k_,
+                              dfa_.transitions_.begin() + (s + 1) * k_);
+    std::sort(row.begin(), row.end());
+    uint32_t result = Dfa::no_state;
+    size_t   best   = 0;
+    for(size_t i = 0; i < row.size();){
+        size_t j = i + 1;
+        while((j < row.size()) && (row[j] == row[i])){
+            ++j;
+        }
+        if((row[i] != Dfa::no_state) && (j - i > best)){
+            best   = j - i;
+            result = row[i];
+        }
+        i = j;
+    }
+    return result;
+}
+
+size_t Table_scanner_generator::number_of_differences(uint32_t s, uint32_t d) const
+{
+    const uint32_t* rs     = dfa_.transitions_.data() + s * k_;
+    const uint32_t* rd     = dfa_.transitions_.data() + d * k_;
+    size_t          result = 0;
+    for(uint32_t c = 0; c < k_; ++c){
+        result += (rs[c] != rd[c]) || (actions_of(s, c) != actions_of(d, c));
+    }
+    return result;
+}
+
+void Table_scanner_generator::choose_defaults()
+{
+    default_.assign(n_, Dfa::no_state);
+    depth_.assign(n_, 0);
+    entries_.resize(n_);
+    std::map<uint32_t, std::vector<uint32_t>> by_target;
+    for(uint32_t s = 0; s < n_; ++s){
+        const uint32_t* row  = dfa_.transitions_.data() + s * k_;
+        size_t          cost = k_ - std::count(row, row + k_, Dfa::no_state);
+        uint32_t        key  = most_frequent_target(s);
+        if(key == Dfa::no_state){
+            continue;
+        }
+        auto& cands = by_target[key];
+        size_t num_of_tried = 0;
+        for(auto it = cands.rbegin(); it != cands.rend(); ++it){
+            if(num_of_tried++ == max_candidates){
+                break;
+            }
+            uint32_t d = *it;
+            if(depth_[d] == max_default_depth){
+                continue;
+            }
+            size_t diff = number_of_differences(s, d);
+            if(diff < cost){
+                cost        = diff;
+                default_[s] = d;
+            }
+        }
+        uint32_t d = default_[s];
+        if(d != Dfa::no_state){
+            depth_[s] = depth_[d] + 1;
+        }
+        for(uint32_t c = 0; c < k_; ++c){
+            bool needed = (d == Dfa::no_state) ? (row[c] != Dfa::no_state) :
+                                                 ((row[c] != dfa_.transitions_[d * k_ + c]) ||
+                                                  (actions_of(s, c) != actions_of(d, c)));
+            if(needed){
+                entries_[s].push_back(Entry{c, row[c]});
+            }
+        }
+        cands.push_back(s);
+    }
+}
+
+void Table_scanner_generator::place_rows()
+{
+    std::vector<uint32_t> order(n_);
+    for(uint32_t s = 0; s < n_; ++s){
+        order[s] = s;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t x, uint32_t y){
+        return entries_[x].size() > entries_[y].size();
+    });
+
+    base_.assign(n_, 0);
+    std::vector<uint8_t> used;
+    size_t               first_free = 0;
+    size_t               comb_size  = 0;
+    for(uint32_t s : order){
+        const auto& es = entries_[s];
+        if(es.empty()){
+            continue;
+        }
+        size_t b = (first_free > es[0].first) ? first_free - es[0].first : 0;
+        for(;; ++b){
+            if(used.size() < b + k_){
+                used.resize(b + k_, 0);
+            }
+            bool fits = std::none_of(es.begin(), es.end(), [&](const Entry& e){
+                return used[b + e.first];
+            });
+            if(fits){
+                break;
+            }
+        }
+        base_[s] = static_cast<uint32_t>(b);
+        for(const auto& e : es){
+            used[b + e.first] = 1;
+            comb_size         = std::max(comb_size, b + e.first + 1);
+            if(next_.size() < comb_size){
+                next_.resize(comb_size, Dfa::no_state);
+                check_.resize(comb_size, Dfa::no_state);
+                actions_.resize(comb_size, 0);
+            }
+            next_[b + e.first]    = e.second;
+            check_[b + e.first]   = s;
+            actions_[b + e.first] = actions_of(s, e.first);
+        }
+        while((first_free < used.size()) && used[first_free]){
+            ++first_free;
+        }
+    }
+    /* Padding, so that base_[s] + k is a valid index for any class k. */
+    next_.resize(comb_size + k_, Dfa::no_state);
+    check_.resize(comb_size + k_, Dfa::no_state);
+    actions_.resize(comb_size + k_, 0);
+}
+
+void Table_scanner_generator::emit_array(const std::string&           type,
+                                         const std::string&           name,
+                                         const std::vector<uint32_t>& values,
+                                         unsigned                     bits)
+{
+    out_ += "    inline constexpr " + type + " " + name + "[] = {";
+    for(size_t i = 0; i < values.size(); ++i){
+        out_ += (i % numbers_per_line) ? " " : "\n        ";
+        out_ += std::to_string(narrow(values[i], bits)) + ",";
+    }
+    if(values.empty()){
+        /* An array of size 0 is ill-formed, e.g. the array of states of an automaton
+         * without states; the entry is never read. */
+        out_ += "\n        0 /* no entries */";
+    }
+    out_ += "\n    };\n\n";
+}
+
+std::string Table_scanner_generator::generate(const std::string&   name,
+                                              Table_scanner_stats& stats)
+{
+    n_ = dfa_.number_of_states();
+    k_ = dfa_.number_of_symbols();
+    choose_defaults();
+    place_rows();
+    flatten_actions();
+    bool has_actions = dfa_.has_actions();
+
+    stats                 = Table_scanner_stats();
+    stats.num_of_states_  = n_;
+    stats.num_of_classes_ = k_;
+    stats.state_bits_     = bits_for_count(n_);
+    stats.index_bits_     = bits_for_value(next_.size());
+    stats.token_bits_     = bits_for_count(lexer_.tokens_.size());
+    stats.class_bits_     = bits_for_value(k_ ? k_ - 1 : 0);
+    stats.set_bits_       = bits_for_value(dfa_.action_sets_.size() - 1);
+    stats.comb_size_      = next_.size() - k_;
+    stats.num_of_defaults_ =
+        n_ - std::count(default_.begin(), default_.end(), Dfa::no_state);
+
+    size_t state_bytes        = stats.state_bits_ / 8;
+    stats.uncompressed_bytes_ = n_ * k_ * state_bytes;
+    stats.compressed_bytes_   = n_ * (stats.index_bits_ / 8 + state_bytes) +
+                                2 * next_.size() * state_bytes;
+    /* The index of blocks is cut after the start of its last run of equal entries. */
+    const auto& full_index    = dfa_.classes_.index();
+    const auto& blocks        = dfa_.classes_.blocks();
+    size_t      index_size    = full_index.size();
+    while((index_size > 1) && (full_index[index_size - 2] == full_index[index_size - 1])){
+        --index_size;
+    }
+    std::vector<uint32_t> index(full_index.begin(), full_index.begin() + index_size);
+    size_t      block_bytes   = blocks.size() * (stats.class_bits_ / 8);
+    stats.class_table_bytes_  = index_size * sizeof(uint16_t) + block_bytes;
+    stats.full_class_bytes_   = full_index.size() * sizeof(uint16_t) + block_bytes;
+    stats.accept_bytes_       = n_ * (stats.token_bits_ / 8);
+    if(has_actions){
+        stats.action_bytes_   = next_.size() * (stats.set_bits_ / 8) +
+                                action_set_begin_.size() * sizeof(uint32_t) +
+                                action_token_.size() * (stats.token_bits_ / 8 +
+                                                        sizeof(uint32_t));
+    }
+
+    std::string state_type = type_of(stats.state_bits_);
+    std::string index_type = type_of(stats.index_bits_);
+    std::string token_type = type_of(stats.token_bits_);
+    std::string class_type = type_of(stats.class_bits_);
+    std::string set_type   = type_of(stats.set_bits_);
+    std::string space      = name + "_tables";
+    std::string guard;
+    for(char c : name){
+        guard += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    guard += "_TABLES_H";
+
+    out_  = "#ifndef " + guard + "\n#define " + guard + "\n";
+    out_ += "#include <cstdint>\n#include \"comb_scanner.h\"\n";
+    size_t other_bytes = stats.accept_bytes_ + stats.action_bytes_;
+    size_t total       = stats.compressed_bytes_ + stats.class_table_bytes_ + other_bytes;
+    size_t full_total  = stats.uncompressed_bytes_ + stats.full_class_bytes_ +
+                         other_bytes;
+    out_ += "/*\n * Tables of the scanner " + name + ": " + std::to_string(n_) +
+            " states, " + std::to_string(k_) + " classes of characters.\n"
+            " * The tables take " + std::to_string(total) + " bytes instead of " +
+            std::to_string(full_total) + " bytes of full tables:\n"
+            " *     transitions:           " + std::to_string(stats.compressed_bytes_) +
+            " bytes instead of " + std::to_string(stats.uncompressed_bytes_) + ";\n"
+            " *     classes of characters: " + std::to_string(stats.class_table_bytes_) +
+            " bytes instead of " + std::to_string(stats.full_class_bytes_) + ".\n"
+            " */\n";
+    out_ += "namespace " + space + "{\n";
+    out_ += "    enum Token : long{\n        None = -1";
+    for(size_t t = 0; t < lexer_.tokens_.size(); ++t){
+        out_ += ",\n        " + token_name(lexer_, t, et_) + " = " + std::to_string(t);
+    }
+    out_ += "\n    };\n\n";
+    if(has_actions){
+        out_ += "    enum Action : uint32_t{";
+        for(size_t a = 0; a < action_names_.size(); ++a){
+            out_ += a ? ",\n        " : "\n        ";
+            out_ += "Action_" + et_.ids_trie->get_utf8_string(action_names_[a]) + " = " +
+                    std::to_string(a);
+        }
+        out_ += "\n    };\n\n";
+    }
+
+    std::vector<uint32_t> accept(dfa_.accept_.begin(), dfa_.accept_.end());
+    emit_array("uint16_t", "class_index",  index,    16);
+    emit_array(class_type, "class_blocks", blocks,   stats.class_bits_);
+    emit_array(index_type, "base",         base_,    stats.index_bits_);
+    emit_array(state_type, "default_state", default_, stats.state_bits_);
+    emit_array(state_type, "next",         next_,    stats.state_bits_);
+    emit_array(state_type, "check",        check_,   stats.state_bits_);
+    emit_array(token_type, "accept",       accept,   stats.token_bits_);
+    if(has_actions){
+        emit_array(set_type,   "transition_actions", actions_,          stats.set_bits_);
+        emit_array("uint32_t", "action_set_begin",   action_set_begin_, 32);
+        emit_array(token_type, "action_token",       action_token_,     stats.token_bits_);
+        emit_array("uint32_t", "action_id",          action_id_,        32);
+    }
+    out_ += "};\n\n";
+
+    std::string tables_type = "Comb_tables<" + state_type + ", " + index_type + ", " +
+                              token_type + ", " + class_type + ", " + set_type + ">";
+    uint32_t    start       = narrow(dfa_.start_, stats.state_bits_);
+    out_ += "inline constexpr " + tables_type + " " + name + " = {\n";
+    for(const char* a : {"class_index", "class_blocks", "base", "default_state", "next",
+                         "check", "accept", "transition_actions", "action_set_begin",
+                         "action_token", "action_id"})
+    {
+        bool is_action_table = std::string(a).find("action") != std::string::npos;
+        if(is_action_table && !has_actions){
+            out_ += "    nullptr,\n";
+        }else{
+            out_ += "    " + space + "::" + a + ",\n";
+        }
+        if(a == std::string("class_index")){
+            out_ += "    " + std::to_string(index_size) + ",\n";
+        }
+    }
+    out_ += "    " + std::to_string(start) + "\n};\n#endif\n";
+    return std::move(out_);
+}
+
+std::string generate_table_scanner(const Lexer_dfa&        lexer,
+                                   const Errors_and_tries& et,
+                                   const std::string&      name,
+                                   Table_scanner_stats&    stats)
+{
+    Table_scanner_generator gen(lexer, et);
+    return gen.generate(name, stats);
+}
+
+void print_table_scanner_stats(const Table_scanner_stats& stats)
+{
+    printf("States: %zu, classes of characters: %zu.\n",
+           stats.num_of_states_, stats.num_of_classes_);
+    printf("Bits of states: %u, of indices: %u, of tokens: %u, of classes: %u.\n",
+           stats.state_bits_, stats.index_bits_, stats.token_bits_, stats.class_bits_);
+    printf("Transitions: %zu bytes instead of %zu bytes "
+           "(%zu default rows, the comb of %zu entries).\n",
+           stats.compressed_bytes_, stats.uncompressed_bytes_,
+           stats.num_of_defaults_, stats.comb_size_);
+    printf("Classes of characters: %zu bytes instead of %zu bytes, "
+           "accepted tokens: %zu bytes.\n",
+           stats.class_table_bytes_, stats.full_class_bytes_, stats.accept_bytes_);
+    if(stats.action_bytes_){
+        printf("Actions: %zu bytes, %u bits of sets of actions.\n",
+               stats.action_bytes_, stats.set_bits_);
+    }
+}
@@ -0,0 +1,285 @@
+/*
+    File:    tagged_dfa.cpp
+    Created: 20 October 2026 at 14:37 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include "../include/tagged_dfa.h"
+#include "../include/flat_ast.h"
+#include "../include/char_conv.h"
+#include "../include/resolve_names.h"
+#include "../include/minimize_dfa.h"
+
+using ast::Flat_ast;
+
+enum class Msg_name{
+    Action_conflict
+};
+
+static const char* messages[] = {
+    "Error in the rule %s: on the input \"%s\" both %s and %s are demanded at the "
+    "last character.\n"
+};
+
+bool Tagged_dfa_builder::Conflict::operator<(const Conflict& rhs) const
+{
+    return std::tie(rule_, action1_, action2_) <
+           std::tie(rhs.rule_, rhs.action1_, rhs.action2_);
+}
+
+Tagged_dfa_builder::Tagged_dfa_builder(const Errors_and_tries&          et,
+                                       const Trie_for_set_of_char32ptr& sets) :
+    et_(et), labels_(sets)
+{
+    pos_begin_.push_back(0);
+}
+
+/* Actions of positions: the action of the outermost node with an action on the path
+ * from the root to the leaf. Parents precede children in the reverse post-order. */
+static std::vector<uint64_t> inherited_actions(const Flat_ast& fa)
+{
+    std::vector<uint64_t> result(fa.actions_.begin(), fa.actions_.end());
+    for(uint32_t i = static_cast<uint32_t>(fa.size()); i-- > 0;){
+        if(!result[i]){
+            continue;
+        }
+        for(auto c = fa.children_begin(i); c != fa.children_end(i); ++c){
+            result[*c] = result[i];
+        }
+    }
+    return result;
+}
+
+void Tagged_dfa_builder::add_rule(const Rule_info& ri)
+{
+    add_rule(ast::to_flat(ri.body_), ri.name_);
+}
+
+void Tagged_dfa_builder::add_rule(const Flat_ast& fa, size_t name)
+{
+    uint32_t rule = static_cast<uint32_t>(automata_.size());
+    auto     acts = inherited_actions(fa);
+    automata_.emplace_back(fa, labels_);
+    names_.push_back(name);
+
+    const Position_automaton& pa = automata_.back();
+    size_t                    n  = pa.number_of_positions();
+    for(uint32_t p = 0; p < n; ++p){
+        rule_of_.push_back(rule);
+        action_of_.push_back(acts[pa.leaf(p)]);
+    }
+    is_last_.resize(is_last_.size() + n, 0);
+    uint32_t first = pos_begin_.back();
+    pa.for_each_last_position([this, first](uint32_t p){
+        is_last_[first + p] = 1;
+    });
+    pos_begin_.push_back(static_cast<uint32_t>(first + n));
+    follow_.emplace_back(n);
+}
+
+void Tagged_dfa_builder::build_alphabet()
+{
+    std::vector<uint32_t> used;
+    for(const auto& pa : automata_){
+        for(uint32_t p = 0; p < pa.number_of_positions(); ++p){
+            used.push_back(pa.label(p));
+        }
+    }
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+    dfa_.classes_ = Char_classes(labels_, used);
+    buckets_.resize(dfa_.number_of_symbols());
+}
+
+uint32_t Tagged_dfa_builder::intern_state(std::vector<uint32_t>& positions,
+                                          uint32_t               parent,
+                                          uint32_t               cls)
+{
+    auto it = state_ids_.find(positions);
+    if(it != state_ids_.end()){
+        return it->second;
+    }
+    uint32_t s    = static_cast<uint32_t>(states_.size());
+    uint32_t rule = Dfa::no_state;
+    for(uint32_t p : positions){
+        if(is_last_[p]){
+            rule = std::min(rule, rule_of_[p]);
+        }
+    }
+    if(positions.empty()){
+        /* The start state accepts nullable rules. */
+        for(uint32_t r = 0; r < automata_.size(); ++r){
+            if(automata_[r].nullable()){
+                rule = r;
+                break;
+            }
+        }
+    }
+    dfa_.accept_.push_back(rule);
+    parent_.push_back(parent);
+    parent_class_.push_back(cls);
+    state_ids_.emplace(positions, s);
+    states_.push_back(std::move(positions));
+    return s;
+}
+
+uint32_t Tagged_dfa_builder::intern_tags(const std::vector<uint32_t>& positions,
+                                         uint32_t                     s,
+                                         uint32_t                     cls)
+{
+    /* Positions are sorted, so positions of the same rule are adjacent. */
+    std::vector<uint64_t> tags;
+    for(size_t i = 0; i < positions.size();){
+        uint32_t rule   = rule_of_[positions[i]];
+        uint64_t action = action_of_[positions[i]];
+        size_t   j      = i + 1;
+        for(; (j < positions.size()) && (rule_of_[positions[j]] == rule); ++j){
+            uint64_t other = action_of_[positions[j]];
+            if(other != action){
+                Conflict c{rule, std::min(action, other), std::max(action, other)};
+                conflicts_.emplace(c, std::make_pair(s, cls));
+            }
+        }
+        if(action){
+            tags.push_back(make_tag(rule, action));
+        }
+        i = j;
+    }
+    if(tags.empty()){
+        return 0;
+    }
+    auto it = action_ids_.find(tags);
+    if(it != action_ids_.end()){
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(dfa_.action_sets_.size());
+    dfa_.action_sets_.push_back(tags);
+    action_ids_.emplace(std::move(tags), id);
+    return id;
+}
+
+void Tagged_dfa_builder::add_row(uint32_t s)
+{
+    size_t num_of_symbols = dfa_.number_of_symbols();
+    size_t row            = dfa_.transitions_.size();
+    dfa_.transitions_.resize(row + num_of_symbols, Dfa::no_state);
+    dfa_.trans_actions_.resize(row + num_of_symbols, 0);
+
+    /* The union of followpos of the positions of the state, or firstpos of all rules
+     * for the start state, gathered rule by rule. */
+    for(auto& f : follow_){
+        f.clear();
+    }
+    if(states_[s].empty()){
+        for(size_t r = 0; r < automata_.size(); ++r){
+            automata_[r].first_positions(follow_[r]);
+        }
+    }else{
+        for(uint32_t p : states_[s]){
+            uint32_t r = rule_of_[p];
+            automata_[r].follow_positions(p - pos_begin_[r], follow_[r]);
+        }
+    }
+
+    touched_.clear();
+    for(uint32_t r = 0; r < automata_.size(); ++r){
+        const Position_automaton& pa    = automata_[r];
+        uint32_t                  first = pos_begin_[r];
+        follow_[r].for_each([&](uint32_t q){
+            uint32_t        l   = pa.label(q);
+            const uint32_t* end = dfa_.classes_.label_classes_end(l);
+            for(auto c = dfa_.classes_.label_classes_begin(l); c != end; ++c){
+                if(buckets_[*c].empty()){
+                    touched_.push_back(*c);
+                }
+                buckets_[*c].push_back(first + q);
+            }
+        });
+    }
+
+    for(uint32_t cls : touched_){
+        std::vector<uint32_t> positions;
+        positions.swap(buckets_[cls]);
+        uint32_t tags                  = intern_tags(positions, s, cls);
+        uint32_t target                = intern_state(positions, s, cls);
+        dfa_.transitions_[row + cls]   = target;
+        dfa_.trans_actions_[row + cls] = tags;
+    }
+}
+
+static std::string action_name(const Errors_and_tries& et, uint64_t action)
+{
+    if(!action){
+        return "no action";
+    }
+    return "$" + et.ids_trie->get_utf8_string(action);
+}
+
+void Tagged_dfa_builder::report_conflicts()
+{
+    for(const auto& c : conflicts_){
+        std::u32string input;
+        input.push_back(dfa_.classes_.ranges(c.second.second)[0].lower_bound);
+        for(uint32_t s = c.second.first; s; s = parent_[s]){
+            input.push_back(dfa_.classes_.ranges(parent_class_[s])[0].lower_bound);
+        }
+        std::reverse(input.begin(), input.end());
+
+        const auto& rule_name = et_.ids_trie->get_utf8_string(names_[c.first.rule_]);
+        auto        str       = u32string_to_utf8(input);
+        auto        act1      = action_name(et_, c.first.action1_);
+        auto        act2      = action_name(et_, c.first.action2_);
+        printf(messages[static_cast<unsigned>(Msg_name::Action_conflict)],
+               rule_name.c_str(),
+               str.c_str(),
+               act1.c_str(),
+               act2.c_str());
+        et_.ec->increment_number_of_errors();
+    }
+}
+
+bool Tagged_dfa_builder::build(Dfa& result)
+{
+    build_alphabet();
+    dfa_.action_sets_.assign(1, std::vector<uint64_t>());
+    std::vector<uint32_t> start;
+    dfa_.start_ = intern_state(start, Dfa::no_state, 0);
+    for(uint32_t s = 0; s < states_.size(); ++s){
+        add_row(s);
+    }
+    if(!conflicts_.empty()){
+        report_conflicts();
+        return false;
+    }
+    if(dfa_.action_sets_.size() == 1){
+        dfa_.trans_actions_.clear();
+    }
+    result = minimize(dfa_);
+    return true;
+}
+
+bool build_tagged_dfa(const std::vector<Rule_info>&    rules,
+                      const Errors_and_tries&          et,
+                      const Trie_for_set_of_char32ptr& sets,
+                      Dfa&                             result)
+{
+    Regexp_name_resolver resolver(et);
+    for(const auto& ri : rules){
+        resolver.add_rule(ri);
+    }
+    if(!resolver.resolve()){
+        return false;
+    }
+    Tagged_dfa_builder builder(et, sets);
+    for(const auto& ri : resolver.expanded_rules()){
+        builder.add_rule(ri);
+    }
+    return builder.build(result);
+}
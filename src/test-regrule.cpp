@@ -8,9 +8,14 @@
 */
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "../include/get_processed_text.h"
 #include "../include/location.h"
 #include "../include/errors_and_tries.h"
@@ -19,12 +24,26 @@
 #include "../include/main_scaner.h"
 #include "../include/expr_scaner.h"
 #include "../include/scope.h"
+#include "../include/session.h"
 // // // // // // // // // // // // // #include "../include/ast.h"
 #include "../include/expr_parser.h"
-// // // // // // // // // // // // // #include "../include/print_ast.h"
+#include "../include/print_ast.h"
 #include "../include/char_conv.h"
 #include "../include/regrule.h"
 #include "../include/print_regrule.h"
+#include "../include/resolve_names.h"
+#include "../include/simplify_ast.h"
+#include "../include/factor_literals.h"
+#include "../include/thompson_nfa.h"
+#include "../include/lazy_dfa.h"
+#include "../include/lower_rules.h"
+#include "../include/tagged_dfa.h"
+#include "../include/lexer_dfa.h"
+#include "../include/table_scanner_gen.h"
+#include "../include/direct_scanner_gen.h"
+#include "../include/ast_serialization.h"
+#include "../include/trie_image.h"
+#include "../include/flat_ast.h"
 // // // // // // // // // // // // // #include "../include/regular_definition_section.h"
 // // // // // // // // // // // // // #include "../include/print_regdef.h"
 
@@ -46,15 +65,13 @@ static const Act_info added_acts[] = {
     {U"add_oct_digit",              U"token.int_value = token.int_value << 3 + digit2int(ch);"}
 };
 
-void add_action(Errors_and_tries&       etr,
-                std::shared_ptr<Scope>& scope,
-                const std::u32string&   name,
-                const std::u32string&   body)
+/* Definition of the action with the name idx and the body body_idx. */
+static void define_action(const std::shared_ptr<Scope>& scope,
+                          size_t                        idx,
+                          size_t                        body_idx)
 {
     Id_attributes iattr;
     iattr.kind_             = 1u << static_cast<uint8_t>(Id_kind::Action_name);
-    size_t idx              = etr.ids_trie -> insert(name);
-    size_t body_idx         = etr.strs_trie-> insert(body);
     iattr.act_string_       = body_idx;
     scope->idsc_[idx]       = iattr;
 
@@ -62,6 +79,16 @@ void add_action(Errors_and_tries&       etr,
     sattr.kind_             = 1u << static_cast<uint16_t>(Str_kind::Action_definition);
     sattr.code_             = 0;
     scope->strsc_[body_idx] = sattr;
+}
+
+void add_action(const Errors_and_tries&       etr,
+                const std::shared_ptr<Scope>& scope,
+                const std::u32string&         name,
+                const std::u32string&         body)
+{
+    size_t idx              = etr.ids_trie -> insert(name);
+    size_t body_idx         = etr.strs_trie-> insert(body);
+    define_action(scope, idx, body_idx);
 
     auto name_in_utf8       = u32string_to_utf8(name);
     printf("Index of action with name %s is %zu.\n", name_in_utf8.c_str(), idx);
@@ -71,30 +98,675 @@ enum Myauka_exit_codes{
     Success, No_args, File_processing_error, Syntax_error
 };
 
-static const char* usage_str = "Usage: %s file\n";
+static const char* usage_str = "Usage: %s [-f text|json|dot] file\n"
+                               "       %s -l file [-o dir] [text]\n"
+                               "       %s -s file\n"
+                               "       %s -i file image\n"
+                               "       %s -r file\n";
+
+/*
+ * The mode -l: all rules of the file are compiled to the automaton of the lexer. The
+ * file consists of definitions
+ *     %action name "body"
+ *     %class_members "members of the class of the direct-coded scanner"
+ *     %keywords "literal", ..., "literal"
+ *     %delimiters "literal", ..., "literal"
+ *     name -> {regexp}
+ * in any order; other declarations, such as %strings, are skipped. The lexeme code of
+ * a keyword or a delimiter is its number in the list. The tokens, the sizes of the
+ * automata and of the generated scanners are printed, and, if the file text is given,
+ * the tokens of this text with the actions executed for them too.
+ *
+ * With -o dir, the direct-coded scanner is written to dir/lexer.h and dir/lexer.cpp,
+ * the tables of the table-driven scanner to dir/lexer_tables.h, and the tokens of the
+ * text, by their indices, to dir/tokens.txt. The test test/lexer/check_scanners.cpp
+ * compiles the generated scanners and compares their tokens and actions with this file.
+ */
+static void add_literals(const std::shared_ptr<Scope>&       scope,
+                         const std::shared_ptr<Main_scaner>& msc,
+                         Str_kind                            kind)
+{
+    size_t code = 0;
+    for(;;){
+        auto li = msc->current_lexem();
+        if(li.code != Main_lexem_code::String){
+            msc->back();
+            return;
+        }
+        Str_attributes sattr;
+        sattr.kind_                    = 1u << static_cast<uint16_t>(kind);
+        sattr.code_                    = code++;
+        scope->strsc_[li.string_index] = sattr;
+        li = msc->current_lexem();
+        if(li.code != Main_lexem_code::Comma){
+            msc->back();
+            return;
+        }
+    }
+}
+
+static void read_definitions(const Errors_and_tries&             et,
+                             const std::shared_ptr<Scope>&       scope,
+                             const std::shared_ptr<Main_scaner>& msc,
+                             const std::shared_ptr<Regrule>&     regrulep,
+                             std::vector<Rule_info>&             rules)
+{
+    for(;;){
+        auto li = msc->current_lexem();
+        switch(li.code){
+            case Main_lexem_code::None:
+                return;
+            case Main_lexem_code::Id:
+                msc->back();
+                rules.push_back(regrulep->compile());
+                break;
+            case Main_lexem_code::Kw_action:
+                {
+                    auto name = msc->current_lexem();
+                    auto body = msc->current_lexem();
+                    if((name.code != Main_lexem_code::Id) ||
+                       (body.code != Main_lexem_code::String))
+                    {
+                        printf("Line %zu expects the name and the body of an action.\n",
+                               msc->lexem_begin_line_number());
+                        et.ec->increment_number_of_errors();
+                        return;
+                    }
+                    define_action(scope, name.ident_index, body.string_index);
+                }
+                break;
+            case Main_lexem_code::Kw_class_members:
+                {
+                    auto members = msc->current_lexem();
+                    if(members.code != Main_lexem_code::String){
+                        printf("Line %zu expects the members of the class of the "
+                               "scanner.\n", msc->lexem_begin_line_number());
+                        et.ec->increment_number_of_errors();
+                        return;
+                    }
+                    Str_attributes sattr;
+                    sattr.kind_ = 1u << static_cast<uint16_t>(Str_kind::Added_members);
+                    scope->strsc_[members.string_index] = sattr;
+                }
+                break;
+            case Main_lexem_code::Kw_keywords:
+                add_literals(scope, msc, Str_kind::Keyword_repres);
+                break;
+            case Main_lexem_code::Kw_delimiters:
+                add_literals(scope, msc, Str_kind::Delimiter_repres);
+                break;
+            default:
+                ;
+        }
+    }
+}
+
+static size_t number_of_lines(const std::string& s)
+{
+    size_t n = 0;
+    for(char c : s){
+        n += (c == '\n');
+    }
+    return n;
+}
+
+/* The search of tokens of all suffixes of the text by the lazy automaton of the
+ * expanded rules is compared with the search by the minimal automaton. */
+static void check_lazy_dfa(const std::vector<Rule_info>&    expanded,
+                           const Trie_for_set_of_char32ptr& sets,
+                           const std::u32string&            text)
+{
+    Label_table  labels(sets);
+    Thompson_nfa nfa(labels);
+    for(size_t i = 0; i < expanded.size(); ++i){
+        ast::Regexp_ast body = ast::simplify(expanded[i].body_, *sets);
+        nfa.add_rule(ast::factor_literals(body), static_cast<uint32_t>(i));
+    }
+    Dfa      dfa        = lower_resolved_rules(expanded, sets);
+    Lazy_dfa lazy(nfa, 0);
+    size_t   mismatches = 0;
+    const char32_t* end = text.data() + text.size();
+    for(const char32_t* p = text.data(); p != end; ++p){
+        Dfa_match m1 = lazy.longest_match(p, end);
+        Dfa_match m2 = dfa.longest_match(p, end);
+        mismatches += (m1.rule_id_ != m2.rule_id_) || (m1.length_ != m2.length_);
+    }
+    printf("Lazy automaton: %zu suffixes, %zu mismatches with the minimal automaton.\n",
+           text.size(), mismatches);
+}
+
+/* The actions of the token t of the length len at p, executed on its characters, as
+ * the list " name:code" of names of actions and codes of characters: */
+static std::string actions_of_token(const Lexer_dfa&        lexer,
+                                    const Errors_and_tries& et,
+                                    const char32_t*         p,
+                                    size_t                  len,
+                                    uint32_t                t)
+{
+    const Dfa&  dfa = lexer.dfa_;
+    std::string result;
+    if(!dfa.has_actions()){
+        return result;
+    }
+    size_t   k = dfa.number_of_symbols();
+    uint32_t s = dfa.start_;
+    for(size_t i = 0; i < len; ++i){
+        uint32_t sym = dfa.symbol_of(p[i]);
+        for(uint64_t tag : dfa.action_sets_[dfa.trans_actions_[s * k + sym]]){
+            if(tag_rule(tag) == t){
+                result += " " + et.ids_trie->get_utf8_string(tag_action(tag)) + ":" +
+                          std::to_string(static_cast<unsigned>(p[i]));
+            }
+        }
+        s = dfa.next(s, sym);
+    }
+    return result;
+}
+
+/* The tokens of the text found by Lexer_dfa::next_token, with their actions. If
+ * by_names is true, then tokens are printed by names, otherwise by indices. */
+static void print_tokens(const Lexer_dfa&        lexer,
+                         const Errors_and_tries& et,
+                         const std::u32string&   text,
+                         FILE*                   out,
+                         bool                    by_names)
+{
+    const char*     ind = by_names ? "    " : "";
+    const char32_t* end = text.data() + text.size();
+    for(const char32_t* p = text.data(); p != end;){
+        Lexer_match m = lexer.next_token(p, end);
+        if(m.token_ == Lexer_match::no_token){
+            fprintf(out, "%sUnknown character with the code %u\n",
+                    ind, static_cast<unsigned>(*p));
+            ++p;
+            continue;
+        }
+        auto lexeme  = u32string_to_utf8(std::u32string(p, m.length_));
+        auto actions = actions_of_token(lexer, et, p, m.length_, m.token_);
+        auto name    = by_names ? token_name(lexer, m.token_, et) :
+                                  std::to_string(m.token_);
+        fprintf(out, "%s%s %s%s\n", ind, name.c_str(), lexeme.c_str(), actions.c_str());
+        p += m.length_;
+    }
+}
+
+static bool write_file(const std::string& name, const std::string& contents)
+{
+    FILE* f = fopen(name.c_str(), "w");
+    if(!f){
+        printf("Could not open the file %s for writing.\n", name.c_str());
+        return false;
+    }
+    fputs(contents.c_str(), f);
+    fclose(f);
+    return true;
+}
+
+/* Reading of all definitions of the file rules_file (see the description of the
+ * mode -l) into the session. */
+static bool read_rules_file(const char*             rules_file,
+                            Session&                session,
+                            std::vector<Rule_info>& rules)
+{
+    std::u32string    text    = get_processed_text(rules_file);
+    if(!text.length()){
+        return false;
+    }
+
+    char32_t*        p        = const_cast<char32_t*>(text.c_str());
+    auto             loc      = std::make_shared<Location>(p);
+    const auto&      et       = session.errors_and_tries();
+    auto             set_trie = session.sets_trie();
+    auto             esc      = std::make_shared<Expr_scaner>(loc, et, set_trie);
+    auto             msc      = std::make_shared<Main_scaner>(loc, et);
+    auto             scope    = session.scope();
+
+    for(const auto& ai : added_acts){
+        add_action(et, scope, ai.name_, ai.body_);
+    }
+
+    auto             ep       = std::make_shared<Expr_parser>(esc, et, scope);
+    auto             regrulep = std::make_shared<Regrule>(ep, msc, et, scope);
+    read_definitions(et, scope, msc, regrulep, rules);
+    return true;
+}
+
+static int compile_lexer(const char* rules_file, const char* text_file, const char* dir)
+{
+    Session                session;
+    std::vector<Rule_info> rules;
+    if(!read_rules_file(rules_file, session, rules)){
+        return File_processing_error;
+    }
+    const auto&            et       = session.errors_and_tries();
+    auto                   set_trie = session.sets_trie();
+    auto                   scope    = session.scope();
+
+    Lexer_dfa lexer;
+    Dfa       tagged;
+    bool      ok      = !et.ec->get_number_of_errors()                     &&
+                        build_lexer_dfa(rules, *scope, et, set_trie, lexer) &&
+                        build_tagged_dfa(rules, et, set_trie, tagged);
+    size_t    nerrors = et.ec->get_number_of_errors();
+    if(!ok || nerrors){
+        printf("Total number of errors: %zu.\n",nerrors);
+        return Syntax_error;
+    }
+
+    printf("Tokens:\n");
+    for(size_t t = 0; t < lexer.tokens_.size(); ++t){
+        const auto& tok  = lexer.tokens_[t];
+        auto        name = token_name(lexer, t, et);
+        if(tok.kind_ == Token_kind::Rule){
+            printf("    %zu %s\n", t, name.c_str());
+        }else{
+            auto literal = et.strs_trie->get_utf8_string(tok.idx_);
+            printf("    %zu %s \"%s\"\n", t, name.c_str(), literal.c_str());
+        }
+    }
+    printf("Automaton of the lexer: %zu states, %zu classes of characters.\n",
+           lexer.dfa_.number_of_states(), lexer.dfa_.number_of_symbols());
+    printf("Tagged automaton of all rules: %zu states.\n", tagged.number_of_states());
+
+    Table_scanner_stats stats;
+    std::string         tables = generate_table_scanner(lexer, et, "lexer", stats);
+    print_table_scanner_stats(stats);
+    Scanner_code code = generate_direct_scanner(lexer, *scope, et, "Lexer", "lexer.h");
+    printf("Direct-coded scanner: %zu lines of the header, %zu lines of the "
+           "implementation.\n",
+           number_of_lines(code.header_), number_of_lines(code.impl_));
+    nerrors = et.ec->get_number_of_errors();
+    if(nerrors){
+        printf("Total number of errors: %zu.\n",nerrors);
+        return Syntax_error;
+    }
+    std::string prefix = dir ? std::string(dir) + "/" : std::string();
+    if(dir && !(write_file(prefix + "lexer.h",        code.header_) &&
+                write_file(prefix + "lexer.cpp",      code.impl_)   &&
+                write_file(prefix + "lexer_tables.h", tables)))
+    {
+        return File_processing_error;
+    }
+    if(!text_file){
+        return Success;
+    }
+
+    std::u32string    input   = get_processed_text(text_file);
+    if(!input.length()){
+        return File_processing_error;
+    }
+    printf("Tokens of the text:\n");
+    print_tokens(lexer, et, input, stdout, true);
+    if(dir){
+        FILE* f = fopen((prefix + "tokens.txt").c_str(), "w");
+        if(!f){
+            printf("Could not open the file %stokens.txt for writing.\n", prefix.c_str());
+            return File_processing_error;
+        }
+        print_tokens(lexer, et, input, f, false);
+        fclose(f);
+    }
+
+    Regexp_name_resolver resolver(et);
+    for(const auto& ri : rules){
+        resolver.add_rule(ri);
+    }
+    resolver.resolve();
+    check_lazy_dfa(resolver.expanded_rules(), set_trie, input);
+    return Success;
+}
+
+/* The rules as the text: names of rules and printed bodies. */
+static std::string rules_text(const std::vector<Rule_info>& rules,
+                              const Errors_and_tries&       et)
+{
+    std::string result;
+    for(const auto& ri : rules){
+        result += et.ids_trie->get_utf8_string(ri.name_) + ":\n";
+        print_ast(ri.body_, result);
+        result += "\n";
+    }
+    return result;
+}
+
+/*
+ * The mode -s: the rules of the file are written into the binary representation by
+ * ast::serialize_rules and loaded back by ast::deserialize_rules. Since the loading
+ * into the same prefix trees keeps all indices, the loaded rules are printed and
+ * compared with the printed source rules. The loading into the prefix trees of a new
+ * session, where indices are other, is checked by writing the loaded rules again and
+ * loading them back into the first session: the printed rules must be the same. Then
+ * all proper prefixes of the binary representation, and all representations with one
+ * byte inverted, are loaded, and it is checked that a rejected representation changes
+ * neither prefix trees nor rules.
+ */
+static int check_serialization(const char* rules_file)
+{
+    Session                session;
+    std::vector<Rule_info> rules;
+    if(!read_rules_file(rules_file, session, rules)){
+        return File_processing_error;
+    }
+    const auto&            et      = session.errors_and_tries();
+    size_t                 nerrors = et.ec->get_number_of_errors();
+    if(nerrors){
+        printf("Total number of errors: %zu.\n",nerrors);
+        return Syntax_error;
+    }
+    auto&       sets  = *session.sets_trie();
+    std::string bytes = ast::serialize_rules(rules, et, sets);
+    printf("Rules: %zu, the binary representation: %zu bytes.\n",
+           rules.size(), bytes.size());
+
+    std::vector<Rule_info> loaded;
+    bool same = ast::deserialize_rules(bytes, et, sets, loaded) &&
+                (rules_text(loaded, et) == rules_text(rules, et));
+    printf("Loading into the same prefix trees: %s.\n",
+           same ? "the printed rules are the same" : "the printed rules differ");
+
+    Session                other;
+    const auto&            oet   = other.errors_and_tries();
+    auto&                  osets = *other.sets_trie();
+    std::vector<Rule_info> reloaded;
+    same = ast::deserialize_rules(bytes, oet, osets, reloaded) &&
+           ast::deserialize_rules(ast::serialize_rules(reloaded, oet, osets),
+                                  et, sets, loaded)                      &&
+           (rules_text(loaded, et) == rules_text(rules, et));
+    printf("Loading into new prefix trees, writing and loading back: %s.\n",
+           same ? "the printed rules are the same" : "the printed rules differ");
+
+    Session     target;
+    const auto& tet            = target.errors_and_tries();
+    auto&       tsets          = *target.sets_trie();
+    size_t      truncated      = 0;
+    size_t      inverted       = 0;
+    size_t      loaded_changed = 0;
+    size_t      changes        = 0;
+    auto        try_load       = [&](std::string_view b){
+        std::vector<ast::Flat_rule_info> frules(1);
+        size_t ids_nodes  = tet.ids_trie->number_of_nodes();
+        size_t sets_nodes = tsets.number_of_nodes();
+        if(ast::deserialize_rules(b, tet, tsets, frules)){
+            return true;
+        }
+        changes += (ids_nodes != tet.ids_trie->number_of_nodes()) ||
+                   (sets_nodes != tsets.number_of_nodes())        ||
+                   (frules.size() != 1) || !frules[0].body_.empty();
+        return false;
+    };
+    for(size_t len = 0; len < bytes.size(); ++len){
+        truncated += !try_load(std::string_view(bytes).substr(0, len));
+    }
+    for(size_t i = 0; i < bytes.size(); ++i){
+        std::string changed = bytes;
+        changed[i]          = static_cast<char>(~changed[i]);
+        bool ok             = try_load(changed);
+        inverted           += !ok;
+        loaded_changed     += ok;
+    }
+    printf("Truncated representations: %zu of %zu are rejected.\n",
+           truncated, bytes.size());
+    printf("Representations with an inverted byte: %zu are rejected, %zu are loaded.\n",
+           inverted, loaded_changed);
+    printf("Rejected representations that changed prefix trees or rules: %zu.\n",
+           changes);
+    return Success;
+}
+
+/* The number of distinct nodes of the DAG with the root root, and the number of nodes
+ * of the tree obtained by unfolding of shared nodes. */
+static void count_nodes(ast::Ast_elem* root, size_t& distinct, uint64_t& unfolded)
+{
+    distinct = 0;
+    unfolded = 0;
+    if(!root){
+        return;
+    }
+    std::unordered_map<const ast::Ast_elem*, uint64_t>        sizes;
+    std::vector<std::pair<ast::Ast_elem*, ast::Node_descr>> stack;
+    stack.push_back(std::make_pair(root, ast::describe(root)));
+    while(!stack.empty()){
+        auto   top    = stack.back();
+        size_t n      = top.second.num_of_children_;
+        bool   ready  = true;
+        for(size_t i = 0; i < n; ++i){
+            ast::Ast_elem* child = top.second.children_[i];
+            if(!sizes.count(child)){
+                stack.push_back(std::make_pair(child, ast::describe(child)));
+                ready = false;
+            }
+        }
+        if(!ready){
+            continue;
+        }
+        stack.pop_back();
+        if(sizes.count(top.first)){
+            continue;
+        }
+        uint64_t size = 1;
+        for(size_t i = 0; i < n; ++i){
+            size += sizes[top.second.children_[i]];
+        }
+        sizes[top.first] = size;
+    }
+    distinct = sizes.size();
+    unfolded = sizes[root];
+}
+
+/*
+ * The mode -r: references %name in the rules of the file are resolved, and for every
+ * expanded rule the number of distinct nodes and the number of nodes of the unfolded
+ * tree are printed. Since the expanded bodies of referenced rules, including their
+ * copies for references with actions, are shared rather than copied, the first number
+ * grows linearly with the depth of nesting of definitions, while the second one can
+ * grow exponentially.
+ */
+static int check_resolution(const char* rules_file)
+{
+    Session                session;
+    std::vector<Rule_info> rules;
+    if(!read_rules_file(rules_file, session, rules)){
+        return File_processing_error;
+    }
+    const auto&            et      = session.errors_and_tries();
+    Regexp_name_resolver   resolver(et);
+    for(const auto& ri : rules){
+        resolver.add_rule(ri);
+    }
+    bool                   ok      = !et.ec->get_number_of_errors() && resolver.resolve();
+    size_t                 nerrors = et.ec->get_number_of_errors();
+    if(!ok || nerrors){
+        printf("Total number of errors: %zu.\n",nerrors);
+        return Syntax_error;
+    }
+    printf("Expanded rules:\n");
+    for(const auto& ri : resolver.expanded_rules()){
+        size_t   distinct;
+        uint64_t unfolded;
+        count_nodes(ri.body_.get_root(), distinct, unfolded);
+        printf("    %s: %zu distinct nodes, %llu nodes of the unfolded tree.\n",
+               et.ids_trie->get_utf8_string(ri.name_).c_str(), distinct,
+               static_cast<unsigned long long>(unfolded));
+    }
+    return Success;
+}
+
+/* Comparison of the image with the prefix tree t: the strings of all nodes and the
+ * search of these strings. */
+static bool image_is_same(const Char_trie_image& image, Char_trie& t)
+{
+    if(image.number_of_nodes() != t.number_of_nodes()){
+        return false;
+    }
+    for(size_t i = 0; i < t.number_of_nodes(); ++i){
+        auto s = t.get_string(i);
+        if((image.get_string(i) != s) || (image.get_length(i) != s.length()) ||
+           (image.find(s) != std::make_pair(true, i)))
+        {
+            return false;
+        }
+    }
+    return !image.find(U"\U0010FFFF").first;
+}
+
+/*
+ * The mode -i: the prefix trees of identifiers and of sets of characters, filled by
+ * the rules of the file, are saved into the file image_file by Char_trie_image::save,
+ * and the file is mapped by Mapped_char_trie_image. The mapped image must give the
+ * same strings, sets and search results as the prefix trees, and the prefix tree
+ * loaded from it by load_into must give the same strings and continue insertions with
+ * the same indices. Then all proper prefixes of the image of identifiers, and all
+ * images in which one link of a node (parent_, first_child_, next_ or path_len_) is
+ * increased by one, are checked by the constructor of Char_trie_image.
+ */
+static int check_trie_image(const char* rules_file, const char* image_file)
+{
+    Session                session;
+    std::vector<Rule_info> rules;
+    if(!read_rules_file(rules_file, session, rules)){
+        return File_processing_error;
+    }
+    const auto& et   = session.errors_and_tries();
+    auto&       ids  = *et.ids_trie;
+    auto&       sets = *session.sets_trie();
+    if(!Char_trie_image::save(ids, image_file)){
+        printf("Could not write the file %s.\n", image_file);
+        return File_processing_error;
+    }
+    printf("Prefix tree of identifiers: %zu nodes.\n", ids.number_of_nodes());
+
+    Mapped_char_trie_image mapped(image_file);
+    bool same = mapped.is_valid() && image_is_same(mapped.image(), ids);
+    printf("Mapped image: %s.\n", same ? "the same strings" : "other strings");
+
+    Char_trie loaded;
+    if(mapped.is_valid()){
+        mapped.image().load_into(loaded);
+    }
+    same = (loaded.number_of_nodes() == ids.number_of_nodes());
+    for(size_t i = 0; same && (i < ids.number_of_nodes()); ++i){
+        same = loaded.get_string(i) == ids.get_string(i);
+    }
+    same = same && (loaded.insert(U"image_test_name") == ids.insert(U"image_test_name"));
+    printf("Loaded prefix tree: %s.\n", same ? "the same strings and insertions" :
+                                                "other strings or insertions");
+
+    std::string     set_bytes = Char_trie_image::build(sets);
+    Char_trie_image set_image(set_bytes.data(), set_bytes.size());
+    same = set_image.is_valid() &&
+           (set_image.number_of_nodes() == sets.number_of_nodes());
+    for(size_t i = 0; same && (i < sets.number_of_nodes()); ++i){
+        same = set_image.get_set(i) == sets.get_set(i);
+    }
+    printf("Image of the prefix tree of sets: %s.\n", same ? "the same sets" :
+                                                               "other sets");
+
+    std::string bytes     = Char_trie_image::build(ids);
+    size_t      truncated = 0;
+    for(size_t len = 0; len < bytes.size(); ++len){
+        std::string prefix = bytes.substr(0, len);
+        truncated         += !Char_trie_image(prefix.data(), prefix.size()).is_valid();
+    }
+    printf("Truncated images: %zu of %zu are rejected.\n", truncated, bytes.size());
+
+    const size_t links[] = {offsetof(Trie_image_node, parent_),
+                            offsetof(Trie_image_node, first_child_),
+                            offsetof(Trie_image_node, next_),
+                            offsetof(Trie_image_node, path_len_)};
+    size_t changed  = 0;
+    size_t rejected = 0;
+    for(size_t i = 0; i < ids.number_of_nodes(); ++i){
+        for(size_t offset : links){
+            std::string corrupted = bytes;
+            char*       field     = corrupted.data() + sizeof(Trie_image_header) +
+                                    i * sizeof(Trie_image_node) + offset;
+            uint64_t    x;
+            memcpy(&x, field, sizeof(x));
+            ++x;
+            memcpy(field, &x, sizeof(x));
+            ++changed;
+            rejected += !Char_trie_image(corrupted.data(), corrupted.size()).is_valid();
+        }
+    }
+    printf("Images with a changed link of a node: %zu of %zu are rejected.\n",
+           rejected, changed);
+    return Success;
+}
 
 int main(int argc, char* argv[])
 {
     if(1 == argc){
-        printf(usage_str, argv[0]);
+        printf(usage_str, argv[0], argv[0], argv[0], argv[0], argv[0]);
         return No_args;
     }
+    if(std::string(argv[1]) == "-l"){
+        if(argc < 3){
+            printf(usage_str, argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return No_args;
+        }
+        const char* text_file = nullptr;
+        const char* dir       = nullptr;
+        for(int i = 3; i < argc; ++i){
+            if((std::string(argv[i]) == "-o") && (i + 1 < argc)){
+                dir = argv[++i];
+            }else{
+                text_file = argv[i];
+            }
+        }
+        return compile_lexer(argv[2], text_file, dir);
+    }
+    if(std::string(argv[1]) == "-s"){
+        if(argc != 3){
+            printf(usage_str, argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return No_args;
+        }
+        return check_serialization(argv[2]);
+    }
+    if(std::string(argv[1]) == "-i"){
+        if(argc != 4){
+            printf(usage_str, argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return No_args;
+        }
+        return check_trie_image(argv[2], argv[3]);
+    }
+    if(std::string(argv[1]) == "-r"){
+        if(argc != 3){
+            printf(usage_str, argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return No_args;
+        }
+        return check_resolution(argv[2]);
+    }
+
+    /* The mode without keys: the file contains one rule, which is printed in the
+     * format given by the key -f, by default as the indented text. */
+    Ast_output_format fmt     = Ast_output_format::Text;
+    int               arg     = 1;
+    if(std::string(argv[1]) == "-f"){
+        std::string name = (argc == 4) ? argv[2] : "";
+        if(name == "json"){
+            fmt = Ast_output_format::Json;
+        }else if(name == "dot"){
+            fmt = Ast_output_format::Dot;
+        }else if(name != "text"){
+            printf(usage_str, argv[0], argv[0], argv[0], argv[0], argv[0]);
+            return No_args;
+        }
+        arg = 3;
+    }
 
-    std::u32string    text    = get_processed_text(argv[1]);
+    std::u32string    text    = get_processed_text(argv[arg]);
     if(!text.length()){
         return File_processing_error;
     }
 
+    Session          session;
     char32_t*        p        = const_cast<char32_t*>(text.c_str());
     auto             loc      = std::make_shared<Location>(p);
-    Errors_and_tries et;
-    et.ec                     = std::make_shared<Error_count>();
-    et.ids_trie               = std::make_shared<Char_trie>();
-    et.strs_trie              = std::make_shared<Char_trie>();
-    auto             set_trie = std::make_shared<Trie_for_set_of_char32>();
+    const auto&      et       = session.errors_and_tries();
+    auto             set_trie = session.sets_trie();
     auto             esc      = std::make_shared<Expr_scaner>(loc, et, set_trie);
     auto             msc      = std::make_shared<Main_scaner>(loc, et);
-    auto             scope    = std::make_shared<Scope>();
+    auto             scope    = session.scope();
 
     for(const auto& ai : added_acts){
         add_action(et, scope, ai.name_, ai.body_);
@@ -108,7 +780,7 @@ int main(int argc, char* argv[])
         printf("Total number of errors: %zu.\n",nerrors);
         return Syntax_error;
     }
-    print_regrule(rule, et.ids_trie);
+    print_regrule(rule, et.ids_trie, fmt);
 // // // // // // // // // // // // //     auto             regdefp  = std::make_shared<regdef_section::Regdef_section>(scope,
 // // // // // // // // // // // // //                                                                                  et,
 // // // // // // // // // // // // //                                                                                  msc,
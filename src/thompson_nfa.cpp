@@ -0,0 +1,255 @@
+/*
+    File:    thompson_nfa.cpp
+    Created: 19 October 2026 at 22:10 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+#include <algorithm>
+#include <utility>
+#include "../include/thompson_nfa.h"
+
+using ast::Flat_ast;
+using ast::Flat_kind;
+
+static bool is_leaf(Flat_kind k)
+{
+    return static_cast<unsigned>(k) >= static_cast<unsigned>(Flat_kind::Regexp_name);
+}
+
+uint32_t Thompson_nfa::new_state(Nfa_state_kind k, uint32_t label, uint64_t action)
+{
+    Nfa_state st;
+    st.kind_   = k;
+    st.out1_   = no_state;
+    st.out2_   = no_state;
+    st.label_  = label;
+    st.action_ = action;
+    states_.push_back(st);
+    return static_cast<uint32_t>(states_.size() - 1);
+}
+
+uint32_t& Thompson_nfa::field(uint32_t slot)
+{
+    Nfa_state& st = states_[slot >> 1];
+    return (slot & 1) ? st.out2_ : st.out1_;
+}
+
+Thompson_nfa::Fragment Thompson_nfa::single(uint32_t s, uint32_t k)
+{
+    uint32_t slot = 2 * s + k;
+    field(slot)   = no_state;
+    return Fragment{s, slot, slot};
+}
+
+Thompson_nfa::Fragment Thompson_nfa::join(const Fragment& a, const Fragment& b)
+{
+    field(a.tail_) = b.head_;
+    return Fragment{a.start_, a.head_, b.tail_};
+}
+
+void Thompson_nfa::patch(const Fragment& f, uint32_t target)
+{
+    uint32_t slot = f.head_;
+    while(slot != no_state){
+        uint32_t& out  = field(slot);
+        uint32_t  next = out;
+        out            = target;
+        slot           = next;
+    }
+}
+
+void Thompson_nfa::build_node(const Flat_ast& fa, uint32_t i)
+{
+    Flat_kind k      = fa.kind(i);
+    uint64_t  action = fa.actions_[i];
+    if(is_leaf(k)){
+        uint32_t s = new_state(Nfa_state_kind::Char, labels_->label_of(k, fa.payloads_[i]),
+                               action);
+        fragments_.push_back(single(s, 0));
+        return;
+    }
+    size_t    n    = fa.num_of_children_[i];
+    size_t    base = fragments_.size() - n;
+    Fragment* f    = fragments_.data() + base;
+    Fragment  result;
+    uint32_t  s;
+    switch(k){
+        case Flat_kind::Or:
+            if(!n){
+                /* The empty alternative does not match anything. */
+                result = single(new_state(Nfa_state_kind::Char, 0, 0), 0);
+                break;
+            }
+            result = f[n - 1];
+            for(size_t j = n - 1; j-- > 0; ){
+                s                = new_state(Nfa_state_kind::Split, 0, 0);
+                states_[s].out1_ = f[j].start_;
+                states_[s].out2_ = result.start_;
+                result           = join(f[j], result);
+                result.start_    = s;
+            }
+            break;
+        case Flat_kind::Concat:
+            if(!n){
+                result = single(new_state(Nfa_state_kind::Eps, 0, 0), 0);
+                break;
+            }
+            for(size_t j = 0; j + 1 < n; ++j){
+                patch(f[j], f[j + 1].start_);
+            }
+            result = Fragment{f[0].start_, f[n - 1].head_, f[n - 1].tail_};
+            break;
+        case Flat_kind::Kleene:
+            s                = new_state(Nfa_state_kind::Split, 0, 0);
+            states_[s].out1_ = f[0].start_;
+            patch(f[0], s);
+            result           = single(s, 1);
+            break;
+        case Flat_kind::Positive:
+            s                = new_state(Nfa_state_kind::Split, 0, 0);
+            states_[s].out1_ = f[0].start_;
+            patch(f[0], s);
+            result           = single(s, 1);
+            result.start_    = f[0].start_;
+            break;
+        default:
+            /* Optional: */
+            s                = new_state(Nfa_state_kind::Split, 0, 0);
+            states_[s].out1_ = f[0].start_;
+            result           = join(f[0], single(s, 1));
+            result.start_    = s;
+            break;
+    }
+    if(action){
+        s = new_state(Nfa_state_kind::Eps, 0, action);
+        patch(result, s);
+        uint32_t start = result.start_;
+        result         = single(s, 0);
+        result.start_  = start;
+    }
+    fragments_.resize(base);
+    fragments_.push_back(result);
+}
+
+uint32_t Thompson_nfa::add_rule(const Flat_ast& fa, uint32_t rule_id)
+{
+    /* Each node gives at most two states; two more states are the accepting state and
+     * the state joining the rule with previous rules. The capacity is at least doubled,
+     * so adding many small rules does not reallocate the array each time. */
+    size_t needed = states_.size() + 2 * fa.size() + 2;
+    if(needed > states_.capacity()){
+        states_.reserve(std::max(needed, 2 * states_.capacity()));
+    }
+    fragments_.clear();
+    size_t n = fa.size();
+    for(uint32_t i = 0; i < n; ++i){
+        build_node(fa, i);
+    }
+    Fragment f = fragments_.empty() ? single(new_state(Nfa_state_kind::Eps, 0, 0), 0) :
+                                      fragments_.back();
+    patch(f, new_state(Nfa_state_kind::Match, rule_id, 0));
+    if(start_ == no_state){
+        start_ = f.start_;
+    }else{
+        uint32_t s       = new_state(Nfa_state_kind::Split, 0, 0);
+        states_[s].out1_ = start_;
+        states_[s].out2_ = f.start_;
+        start_           = s;
+    }
+    return f.start_;
+}
+
+uint32_t Thompson_nfa::add_rule(const ast::Regexp_ast& tree, uint32_t rule_id)
+{
+    return add_rule(ast::to_flat(tree), rule_id);
+}
+
+std::vector<uint32_t> Thompson_nfa::used_labels() const
+{
+    std::vector<uint8_t>  used(labels_ ? labels_->size() : 0, 0);
+    std::vector<uint32_t> result;
+    for(const auto& st : states_){
+        if((st.kind_ == Nfa_state_kind::Char) && !used[st.label_]){
+            used[st.label_] = 1;
+            result.push_back(st.label_);
+        }
+    }
+    return result;
+}
+
+void Thompson_nfa::add_closure(uint32_t               s,
+                               Sparse_set&            set,
+                               std::vector<uint32_t>& stack) const
+{
+    stack.clear();
+    stack.push_back(s);
+    while(!stack.empty()){
+        uint32_t t = stack.back();
+        stack.pop_back();
+        if(!set.insert(t)){
+            continue;
+        }
+        const Nfa_state& st = states_[t];
+        switch(st.kind_){
+            case Nfa_state_kind::Split:
+                stack.push_back(st.out2_);
+                stack.push_back(st.out1_);
+                break;
+            case Nfa_state_kind::Eps:
+                stack.push_back(st.out1_);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+Nfa_simulator::Nfa_simulator(const Thompson_nfa& nfa) :
+    nfa_(nfa), current_(nfa.size()), next_(nfa.size())
+{
+}
+
+uint32_t Nfa_simulator::accepted_rule() const
+{
+    uint32_t rule = Thompson_nfa::no_state;
+    for(uint32_t s : current_){
+        const Nfa_state& st = nfa_.state(s);
+        if((st.kind_ == Nfa_state_kind::Match) && (st.label_ < rule)){
+            rule = st.label_;
+        }
+    }
+    return rule;
+}
+
+Nfa_match Nfa_simulator::longest_match(const char32_t* begin, const char32_t* end)
+{
+    Nfa_match result;
+    current_.clear();
+    if(nfa_.start() == Thompson_nfa::no_state){
+        return result;
+    }
+    nfa_.add_closure(nfa_.start(), current_, stack_);
+    result.rule_id_ = accepted_rule();
+    const Label_table& labels = nfa_.labels();
+    for(const char32_t* p = begin; (p != end) && !current_.empty(); ++p){
+        next_.clear();
+        for(uint32_t s : current_){
+            const Nfa_state& st = nfa_.state(s);
+            if((st.kind_ == Nfa_state_kind::Char) &&
+               ranges_contain(labels.ranges(st.label_), *p))
+            {
+                nfa_.add_closure(st.out1_, next_, stack_);
+            }
+        }
+        std::swap(current_, next_);
+        uint32_t rule = accepted_rule();
+        if(rule != Thompson_nfa::no_state){
+            result.length_  = (p - begin) + 1;
+            result.rule_id_ = rule;
+        }
+    }
+    return result;
+}
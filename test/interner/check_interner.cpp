@@ -0,0 +1,151 @@
+/*
+    File:    check_interner.cpp
+    Created: 20 October 2026 at 18:40 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+/*
+ * The test of Concurrent_interner. Several threads insert the same list of strings,
+ * each in its own random order, so that the ids given by insert depend on the
+ * interleaving of threads. The test checks that
+ *     1) all threads receive the same id for the same string, and find returns it;
+ *     2) the number of interned strings is the number of distinct strings;
+ *     3) after renumber(), the ids are the numbers of strings in the lexicographic
+ *        order, and the mapping returned by renumber() translates the ids received by
+ *        threads into these numbers;
+ *     4) export_to_trie gives the same indices in the prefix tree as for the interner
+ *        filled by one thread in the reverse order.
+ * Since the ids after renumber() and the indices after export_to_trie do not depend
+ * on the order of insertions, the output of the test is the same in all runs.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../include/concurrent_interner.h"
+#include "../../include/char_trie.h"
+
+static constexpr size_t num_of_distinct = 3000;
+
+/* Strings with common prefixes, non-Latin letters and repetitions. */
+static std::vector<std::u32string> make_strings()
+{
+    static const std::u32string prefixes[] = {U"a", U"ab", U"name_", U"имя", U"x"};
+    std::vector<std::u32string> result;
+    for(size_t k = 0; k < num_of_distinct; ++k){
+        std::u32string s = prefixes[k % 5];
+        for(size_t m = k / 5; m; m /= 7){
+            s += static_cast<char32_t>(U'0' + m % 7);
+        }
+        result.push_back(s);
+        if(k % 3 == 0){
+            result.push_back(s);
+        }
+    }
+    return result;
+}
+
+static void insert_in_parallel(Concurrent_interner&               interner,
+                               const std::vector<std::u32string>& strs,
+                               size_t                             num_of_threads,
+                               unsigned                           seed,
+                               std::vector<std::vector<size_t>>&  ids)
+{
+    ids.assign(num_of_threads, std::vector<size_t>(strs.size()));
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < num_of_threads; ++t){
+        threads.emplace_back([&interner, &strs, &ids, seed, t]{
+            std::vector<size_t> order(strs.size());
+            for(size_t i = 0; i < order.size(); ++i){
+                order[i] = i;
+            }
+            std::mt19937 gen(seed * 100 + static_cast<unsigned>(t));
+            std::shuffle(order.begin(), order.end(), gen);
+            for(size_t i : order){
+                ids[t][i] = interner.insert(strs[i]);
+            }
+        });
+    }
+    for(auto& th : threads){
+        th.join();
+    }
+}
+
+static bool check(const std::vector<std::u32string>& strs,
+                  const std::vector<size_t>&         reference_indices,
+                  size_t                             num_of_threads,
+                  unsigned                           seed)
+{
+    Concurrent_interner              interner;
+    std::vector<std::vector<size_t>> ids;
+    insert_in_parallel(interner, strs, num_of_threads, seed, ids);
+
+    bool same_ids = true;
+    for(size_t i = 0; i < strs.size(); ++i){
+        for(size_t t = 0; t < num_of_threads; ++t){
+            same_ids = same_ids && (ids[t][i] == ids[0][i]);
+        }
+        same_ids = same_ids &&
+                   (interner.find(strs[i]) == std::make_pair(true, ids[0][i]));
+    }
+    bool right_size = interner.size() == num_of_distinct;
+
+    std::set<std::u32string> sorted(strs.begin(), strs.end());
+    auto                     old2new    = interner.renumber();
+    bool                     renumbered = true;
+    size_t                   rank       = 0;
+    for(const auto& s : sorted){
+        ++rank;
+        renumbered = renumbered && (interner.find(s) == std::make_pair(true, rank));
+    }
+    for(size_t i = 0; i < strs.size(); ++i){
+        renumbered = renumbered && (interner.find(strs[i]).second == old2new[ids[0][i]]);
+    }
+
+    Char_trie trie;
+    auto      indices  = interner.export_to_trie(trie);
+    bool      exported = indices == reference_indices;
+    auto      table    = interner.get_strings();
+    for(size_t i = 1; i < table.size(); ++i){
+        exported = exported && (trie.get_string(indices[i]) == table[i]);
+    }
+
+    printf("Threads: %zu, seed: %u: %s, %s, %s, %s.\n",
+           num_of_threads, seed,
+           same_ids   ? "the same ids in all threads"    : "different ids",
+           right_size ? "the right number of strings"    : "a wrong number of strings",
+           renumbered ? "renumber() gives the same ids"  : "renumber() gives other ids",
+           exported   ? "export_to_trie() gives the same indices" :
+                        "export_to_trie() gives other indices");
+    return same_ids && right_size && renumbered && exported;
+}
+
+int main()
+{
+    auto strs = make_strings();
+
+    Concurrent_interner reference;
+    for(auto it = strs.rbegin(); it != strs.rend(); ++it){
+        reference.insert(*it);
+    }
+    reference.renumber();
+    Char_trie reference_trie;
+    auto      reference_indices = reference.export_to_trie(reference_trie);
+
+    size_t failures = 0;
+    for(size_t num_of_threads : {1, 2, 4, 8}){
+        for(unsigned seed = 1; seed <= 3; ++seed){
+            failures += !check(strs, reference_indices, num_of_threads, seed);
+        }
+    }
+    printf("Failures: %zu.\n", failures);
+    return failures ? 1 : 0;
+}
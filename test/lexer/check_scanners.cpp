@@ -0,0 +1,146 @@
+/*
+    File:    check_scanners.cpp
+    Created: 20 October 2026 at 18:20 Moscow time
+    Author:  Гаврилов Владимир Сергеевич
+    E-mails: vladimir.s.gavrilov@gmail.com
+             gavrilov.vladimir.s@mail.ru
+             gavvs1977@yandex.ru
+*/
+
+/*
+ * The test of generated scanners. It is compiled together with the files written by
+ *     test-regrule -l test/lexer/actions.txt -o dir text
+ * (see test/lexer/Makefile), scans the text by the direct-coded scanner or by the
+ * tables of the table-driven scanner, and prints the tokens and the executed actions
+ * in the format of dir/tokens.txt, which is written by test-regrule from
+ * Lexer_dfa::next_token. The actions of test/lexer/actions.txt append their names and
+ * the codes of characters to the member trace_ of the direct-coded scanner; for the
+ * tables, the handler of actions does the same.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "lexer.h"
+#include "lexer_tables.h"
+
+/* Decoding of UTF-8 without checks: the text is written by the test itself. */
+static std::u32string read_text(const char* name)
+{
+    std::u32string result;
+    FILE*          f = fopen(name, "rb");
+    if(!f){
+        return result;
+    }
+    int c;
+    while((c = fgetc(f)) != EOF){
+        char32_t ch    = static_cast<unsigned char>(c);
+        int      extra = (ch >= 0xF0) ? 3 : (ch >= 0xE0) ? 2 : (ch >= 0xC0) ? 1 : 0;
+        if(extra){
+            ch &= 0x3F >> extra;
+        }
+        for(int i = 0; i < extra; ++i){
+            ch = (ch << 6) | (fgetc(f) & 0x3F);
+        }
+        result += ch;
+    }
+    fclose(f);
+    return result;
+}
+
+static std::string to_utf8(const char32_t* begin, const char32_t* end)
+{
+    std::string result;
+    for(const char32_t* p = begin; p != end; ++p){
+        char32_t c = *p;
+        if(c < 0x80){
+            result += static_cast<char>(c);
+        }else if(c < 0x800){
+            result += static_cast<char>(0xC0 | (c >> 6));
+            result += static_cast<char>(0x80 | (c & 0x3F));
+        }else if(c < 0x10000){
+            result += static_cast<char>(0xE0 | (c >> 12));
+            result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (c & 0x3F));
+        }else{
+            result += static_cast<char>(0xF0 | (c >> 18));
+            result += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            result += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            result += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return result;
+}
+
+static void print_token(long token, const char32_t* begin, const char32_t* end,
+                        const std::string& actions)
+{
+    printf("%ld %s%s\n", token, to_utf8(begin, end).c_str(), actions.c_str());
+}
+
+static void check_direct(const std::u32string& text)
+{
+    Lexer           lexer;
+    const char32_t* p   = text.data();
+    const char32_t* end = p + text.size();
+    while(p != end){
+        const char32_t* begin = p;
+        lexer.trace_.clear();
+        int token = lexer.next_token(p, end);
+        if(token == Lexer::None){
+            printf("Unknown character with the code %u\n", static_cast<unsigned>(*p));
+            ++p;
+            continue;
+        }
+        print_token(token, begin, p, lexer.trace_);
+    }
+}
+
+static const char* action_name(uint32_t action)
+{
+    switch(action){
+        case lexer_tables::Action_write:
+            return "write";
+        case lexer_tables::Action_add_dec_digit:
+            return "add_dec_digit";
+        case lexer_tables::Action_add_hex_digit:
+            return "add_hex_digit";
+        default:
+            return "unknown";
+    }
+}
+
+static void check_tables(const std::u32string& text)
+{
+    const char32_t* p   = text.data();
+    const char32_t* end = p + text.size();
+    while(p != end){
+        const char32_t* begin = p;
+        std::string     trace;
+        long token = lexer.longest_match(p, end, [&trace](uint32_t action, char32_t ch){
+            trace += std::string(" ") + action_name(action) + ":" + std::to_string(ch);
+        });
+        if(token == lexer_tables::None){
+            printf("Unknown character with the code %u\n", static_cast<unsigned>(*p));
+            ++p;
+            continue;
+        }
+        print_token(token, begin, p, trace);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string mode = (argc == 3) ? argv[1] : "";
+    if((mode != "direct") && (mode != "tables")){
+        printf("Usage: %s direct|tables text\n", argv[0]);
+        return 1;
+    }
+    std::u32string text = read_text(argv[2]);
+    if(mode == "direct"){
+        check_direct(text);
+    }else{
+        check_tables(text);
+    }
+    return 0;
+}